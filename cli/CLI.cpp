@@ -43,174 +43,661 @@
  */
 
 #include "CLI.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
 
 using namespace std::literals;
 
 namespace microhal {
 
-void CLI::addSign(char sign) {
-    /* Arrow sign is 0xe0 followed by: 0x48 (up), 0x50 (down), 0x4b (left), 0x4d (right) */
-    static uint8_t arrowSign = 0;
-    static uint8_t previous_CR = 0;
-    constexpr uint8_t maxLen = LINELENGTH - 2; /* Space and NULL termination */
+namespace {
+using Word = uintptr_t;
 
-    if (previous_CR) {
-        if (sign == '\n') return;
-        previous_CR = 0;
+constexpr Word repeatByte(uint8_t byte) {
+    return static_cast<Word>(~Word{0}) / 0xFF * byte;
+}
+
+constexpr bool isSpecialChar(char sign) {
+    const uint8_t byte = sign;
+    return byte < 0x20 || byte == 127;
+}
+
+/**
+ * Marks with most significant bit bytes of the word that are control chars (lower than space) or DEL. Only the least
+ * significant marked byte is exact, bytes above it may be marked because of borrow propagation.
+ */
+constexpr Word specialCharsMask(Word word) {
+    constexpr Word ones = repeatByte(0x01);
+    constexpr Word highBits = repeatByte(0x80);
+    const Word control = (word - repeatByte(0x20)) & ~word & highBits;
+    const Word del = word ^ repeatByte(127);
+    return control | ((del - ones) & ~del & highBits);
+}
+
+/**
+ * @return position of first char that needs processing by CLI::addSign, or text size if there is no such char.
+ */
+size_t findSpecialChar(std::string_view text) {
+    size_t pos = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        // word at a time
+        for (; pos + sizeof(Word) <= text.size(); pos += sizeof(Word)) {
+            Word word;
+            std::copy_n(&text[pos], sizeof(Word), reinterpret_cast<char *>(&word));
+            if (const auto mask = specialCharsMask(word); mask) return pos + std::countr_zero(mask) / 8;
+        }
+    }
+    for (; pos < text.size(); pos++) {
+        if (isSpecialChar(text[pos])) return pos;
     }
+    return pos;
+}
+
+size_t commonPrefixLength(std::string_view a, std::string_view b) {
+    const auto [end, _] = std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin());
+    return std::distance(a.begin(), end);
+}
+}  // namespace
 
-    /* In case previous char was arrow sign */
-    if (arrowSign == 2) {
-        arrowSign = 0;
-        switch (sign) {
-            /* UP */
-            case 'A':
-                showPreviousCommand();
-                return;
-                /* DOWN */
-            case 'B':
-                showNextCommand();
-                return;
-                /* LEFT */
-            case 'D':
-                /* RIGTH */
-            case 'C':
-                return;
+/**
+ * @brief Line visible on console assembled from several parts, so search line doesn't need own buffer.
+ */
+struct CLIBase::LineView {
+    std::array<std::string_view, 4> parts;
+
+    LineView(std::string_view text) : parts{text} {}
+    LineView(std::string_view a, std::string_view b, std::string_view c, std::string_view d) : parts{a, b, c, d} {}
+
+    size_t size() const {
+        size_t size = 0;
+        for (auto part : parts)
+            size += part.size();
+        return size;
+    }
+
+    char operator[](size_t index) const {
+        for (auto part : parts) {
+            if (index < part.size()) return part[index];
+            index -= part.size();
+        }
+        return 0;
+    }
+
+    size_t commonPrefixLength(const LineView &other) const {
+        const size_t maxLength = std::min(size(), other.size());
+        size_t length = 0;
+        while (length < maxLength && (*this)[length] == other[length])
+            length++;
+        return length;
+    }
+
+    void write(IODevice &device, size_t from, size_t to) const {
+        for (auto part : parts) {
+            if (from < part.size() && from < to) device.write(part.substr(from, to - from));
+            from -= std::min(from, part.size());
+            to -= std::min(to, part.size());
         }
     }
+};
+
+void CLIBase::readInput(CommandTask::Clock::time_point now) {
+    constexpr ssize_t chunkSize = INPUTCHUNKLENGTH;
+    char chunk[chunkSize];
+    ssize_t received;
+    // drain console, don't leave anything for next wakeup
+    do {
+        received = port.read(chunk, chunkSize);
+        if (received > 0) addChars({chunk, static_cast<size_t>(received)});
+    } while (received > 0 && (received == chunkSize || port.availableBytes() > 0));
+    if (menu.task) resumeTask(now);
+    if (commandFinished()) finishCommand();
+    output.flush();
+}
+
+void CLIBase::addChars(std::string_view input) {
+    if (machineMode) return addRequestChars(input);
+    while (input.size()) {
+        // asynchronous command was started, rest of input waits until it finishes
+        if (menu.commandRunning()) return addTypeahead(input);
+        // escape sequence, CR LF pair or search in progress, this char has to go through state machine
+        if (escapeState || previous_CR || searching) {
+            addSign(input.front());
+            input.remove_prefix(1);
+            continue;
+        }
+        auto specialCharPos = findSpecialChar(input);
+        if (specialCharPos) insertText(input.substr(0, specialCharPos));
+        if (specialCharPos < input.size()) addSign(input[specialCharPos++]);
+        input.remove_prefix(specialCharPos);
+    }
+}
+
+void CLIBase::insertText(std::string_view text) {
+    completionPending = false;
+    if (length >= maxLineLength) return;
+    text = text.substr(0, maxLineLength - length);
+    if (historyShown) duplicateCommand();
+    const uint8_t oldLength = length;
+    std::copy_backward(&line[cursor], &line[length], &line[length + text.size()]);
+    text.copy(&line[cursor], text.size());
+    length += text.size();
+    redraw(cursor, oldLength, cursor + text.size());
+}
+
+void CLIBase::eraseChars(uint8_t position, uint8_t count) {
+    if (historyShown) duplicateCommand();
+    if (position + count > length) return;
+    const uint8_t oldLength = length;
+    std::copy(&line[position + count], &line[length], &line[position]);
+    length -= count;
+    redraw(position, oldLength, position);
+}
+
+void CLIBase::addSign(char sign) {
+    if (previous_CR) {
+        previous_CR = 0;
+        if (sign == '\n') return;
+    }
+
+    if (sign != '\t') completionPending = false;
+
+    if (escapeState && processEscapeSequence(sign)) return;
+
+    if (searching && processSearchKey(sign)) return;
 
     switch (sign) {
         case '\b':
         case 127:
-            if (previousBuffer != activeBuffer) duplicateCommand();
-            if (charDelete(1)) cleanLine(1);
+            if (cursor > 0) eraseChars(cursor - 1, 1);
             return;
         case '\t':
-            if (previousBuffer != activeBuffer) duplicateCommand();
-            showCommands();
+            if (historyShown) duplicateCommand();
+            completeCommand();
             return;
-            break;
-
         case '\r':
             previous_CR = 1;
+            [[fallthrough]];
         case '\n':
-            if (previousBuffer != activeBuffer) duplicateCommand();
+            if (historyShown) duplicateCommand();
             processBuffer();
             return;
+        case 27:
+            escapeState = Escape;
+            return;
+        /* Ctrl-R */
+        case 18:
+            startSearch();
+            return;
+    }
+
+    insertText({&sign, 1});
+}
+
+bool CLIBase::processEscapeSequence(char sign) {
+    switch (escapeState) {
+        case Escape:
+            escapeState = None;
+            if (sign == '[') {
+                escapeState = ControlSequence;
+                escapeParameter = 0;
+                return true;
+            }
+            if (sign == 'O') {
+                escapeState = SingleShift;
+                return true;
+            }
+            // not an escape sequence, process char normally
+            return false;
+        case ControlSequence:
+            if (sign >= '0' && sign <= '9') {
+                // saturate, so too long parameter can't wrap around to code of some key
+                const unsigned int parameter = escapeParameter * 10u + (sign - '0');
+                escapeParameter = parameter < UINT8_MAX ? parameter : UINT8_MAX;
+                return true;
+            }
+            if (sign == ';') return true;
+            escapeState = None;
+            // sequence interrupted by control char
+            if (sign < 0x40 || sign > 0x7E) return false;
             break;
+        case SingleShift:
+            escapeState = None;
+            break;
+        default:
+            escapeState = None;
+            return false;
     }
 
     switch (sign) {
-        case 27:
-            if (arrowSign == 0) arrowSign = 1;
-            return;
+        /* UP */
+        case 'A':
+            showPreviousCommand();
             break;
-        case 91:
-            if (arrowSign == 1) arrowSign = 2;
-            return;
+        /* DOWN */
+        case 'B':
+            showNextCommand();
             break;
-        default:
-            arrowSign = 0;
+        /* RIGHT */
+        case 'C':
+            if (cursor < length) moveCursor(cursor + 1);
+            break;
+        /* LEFT */
+        case 'D':
+            if (cursor > 0) moveCursor(cursor - 1);
+            break;
+        case 'H':
+            moveCursor(0);
+            break;
+        case 'F':
+            moveCursor(length);
+            break;
+        /* VT220 editing keys: ESC [ n ~ */
+        case '~':
+            switch (escapeParameter) {
+                case 1:
+                case 7:
+                    moveCursor(0);
+                    break;
+                case 3:
+                    if (cursor < length) eraseChars(cursor, 1);
+                    break;
+                case 4:
+                case 8:
+                    moveCursor(length);
+                    break;
+            }
+            break;
+    }
+    return true;
+}
+
+void CLIBase::moveCursor(uint8_t position) {
+    if (position < cursor) {
+        moveCursorLeft(cursor - position);
+    } else if (position > cursor) {
+        const uint8_t count = position - cursor;
+        // for short distance reprinting chars is cheaper than escape sequence
+        if (count <= 4) {
+            output.write(&shownLine()[cursor], count);
+        } else {
+            writeCursorSequence(count, 'C');
+        }
+    }
+    cursor = position;
+}
+
+void CLIBase::moveCursorLeft(uint8_t count) {
+    if (count <= 4) {
+        for (uint8_t i = 0; i < count; i++)
+            output.putChar(del);
+    } else {
+        writeCursorSequence(count, 'D');
     }
+}
+
+void CLIBase::writeCursorSequence(uint8_t count, char command) {
+    char sequence[] = {27, '[', 0, 0, 0, 0};
+    auto end = std::to_chars(&sequence[2], &sequence[5], count).ptr;
+    *end++ = command;
+    output.write(sequence, end - sequence);
+}
 
-    if (length < maxLen) {
-        if (previousBuffer != activeBuffer) duplicateCommand();
-        // charAppend(sign);
-        if (sign == charAppend(sign)) port.write(&sign, 1);
+void CLIBase::redraw(uint8_t from, uint8_t oldLength, uint8_t newCursor) {
+    moveCursor(from);
+    output.write(&shownLine()[from], length - from);
+    cursor = length;
+    if (oldLength > length) {
+        const uint8_t leftovers = oldLength - length;
+        if (leftovers < 3) {
+            for (uint8_t i = 0; i < leftovers; i++)
+                output.putChar(space);
+            cursor += leftovers;
+        } else {
+            // erase to end of line
+            output.write("\x1b[K"sv);
+        }
     }
+    moveCursor(newCursor);
 }
 
-void CLI::showPreviousCommand() {
-    uint8_t tmpPrev = previousBuffer;
-    if (tmpPrev == 0) {
-        tmpPrev = BUFFERLENGTH - 1;
+void CLIBase::replaceLine(bool fromHistory, uint16_t entry) {
+    const auto oldLine = std::string_view(shownLine(), length);
+    // edited line is kept while history is browsed
+    if (!historyShown) line[length] = 0;
+    historyShown = fromHistory;
+    shownEntry = entry;
+    const auto newLine = fromHistory ? history[entry] : std::string_view(line);
+    length = newLine.size();
+    // only part that differs from line visible on terminal is sent
+    redraw(commonPrefixLength(oldLine, newLine), oldLine.size(), length);
+}
+
+void CLIBase::showPreviousCommand() {
+    if (!historyShown) {
+        if (!history.empty()) replaceLine(true, history.newest());
+    } else if (shownEntry != history.oldest()) {
+        replaceLine(true, history.older(shownEntry));
+    }
+}
+
+void CLIBase::showNextCommand() {
+    if (historyShown) {
+        if (shownEntry == history.newest()) {
+            replaceLine(false, 0);
+        } else {
+            replaceLine(true, history.newer(shownEntry));
+        }
+    }
+}
+
+void CLIBase::duplicateCommand() {
+    // entry from persistent history could be written by CLI with longer lines
+    const auto entry = history[shownEntry].substr(0, maxLineLength);
+    entry.copy(line, entry.size());
+    historyShown = false;
+    if (entry.size() < length) {
+        const uint8_t oldLength = length;
+        length = entry.size();
+        redraw(length, oldLength, std::min(cursor, length));
+    }
+}
+
+void CLIBase::redrawView(const LineView &oldView, const LineView &newView) {
+    const size_t from = oldView.commonPrefixLength(newView);
+    if (cursor > from) {
+        moveCursorLeft(cursor - from);
     } else {
-        tmpPrev--;
+        oldView.write(output, cursor, from);
     }
-    if (tmpPrev != activeBuffer) {
-        /* If previous command exists */
-        if (dataBuffer[tmpPrev][0] != '\0') {
-            cleanLine(length);  // Cleaning current line
-            charAppend(0);
-            /* Setting line from history, and printing its content */
-            previousBuffer = tmpPrev;
-            length = strlen(dataBuffer[previousBuffer]);
-            port.write(dataBuffer[previousBuffer]);
+    newView.write(output, from, newView.size());
+    cursor = newView.size();
+    if (oldView.size() > newView.size()) {
+        const uint8_t leftovers = oldView.size() - newView.size();
+        if (leftovers < 3) {
+            for (uint8_t i = 0; i < leftovers; i++)
+                output.putChar(space);
+            moveCursorLeft(leftovers);
+        } else {
+            // erase to end of line
+            output.write("\x1b[K"sv);
+        }
+    }
+}
+
+void CLIBase::startSearch() {
+    const LineView oldView(std::string_view(shownLine(), length));
+    searching = true;
+    searchLength = 0;
+    searchMatches[0] = noMatch;
+    redrawView(oldView, searchView());
+}
+
+bool CLIBase::processSearchKey(char sign) {
+    const LineView oldView = searchView();
+    switch (sign) {
+        /* Ctrl-R, look for older entry containing searched text */
+        case 18: {
+            const uint16_t match = searchMatches[searchLength];
+            if (searchLength == 0 || searchFailed() || match == history.oldest()) return true;
+            if (const uint16_t older = findMatch(history.older(match)); older != noMatch) searchMatches[searchLength] = older;
+            break;
         }
+        /* Ctrl-G, abandon search */
+        case 7:
+            finishSearch(false);
+            return true;
+        case '\b':
+        case 127:
+            if (searchLength == 0) return true;
+            searchLength--;
+            break;
+        default:
+            if (isSpecialChar(sign)) {
+                finishSearch(true);
+                return false;
+            }
+            if (searchLength == SEARCHLENGTH) return true;
+            searchPattern[searchLength] = sign;
+            const uint16_t match = searchMatches[searchLength];
+            const bool failed = searchFailed();
+            searchLength++;
+            // entries newer than the last match don't contain shorter text, so they can't contain the longer one
+            uint16_t found = noMatch;
+            if (!failed && !history.empty()) found = findMatch(match == noMatch ? history.newest() : match);
+            searchMatches[searchLength] = found != noMatch ? found : match;
+            break;
     }
+    redrawView(oldView, searchView());
+    return true;
 }
 
-void CLI::showNextCommand() {
-    uint8_t tmpPrev = previousBuffer;
-    if (tmpPrev != activeBuffer) {
-        tmpPrev = (tmpPrev + 1) % BUFFERLENGTH;
-        cleanLine(length);
-        charAppend(0);
-        previousBuffer = tmpPrev;
-        length = strlen(dataBuffer[previousBuffer]);
-        port.write(dataBuffer[previousBuffer]);
+uint16_t CLIBase::findMatch(uint16_t from) const {
+    const std::string_view pattern(searchPattern, searchLength);
+    for (uint16_t position = from;; position = history.older(position)) {
+        if (history[position].find(pattern) != std::string_view::npos) return position;
+        if (position == history.oldest()) return noMatch;
     }
 }
 
-void CLI::duplicateCommand() {
-    memcpy(dataBuffer[activeBuffer], dataBuffer[previousBuffer], length);
-    previousBuffer = activeBuffer;
+bool CLIBase::searchFailed() const {
+    if (searchLength == 0) return false;
+    const uint16_t match = searchMatches[searchLength];
+    return match == noMatch || history[match].find(std::string_view(searchPattern, searchLength)) == std::string_view::npos;
+}
+
+CLIBase::LineView CLIBase::searchView() const {
+    const auto label = searchFailed() ? "(failed reverse-i-search)`"sv : "(reverse-i-search)`"sv;
+    const uint16_t match = searchMatches[searchLength];
+    auto entry = match != noMatch ? history[match] : std::string_view{};
+    // search line mustn't be longer than ordinary line
+    entry = entry.substr(0, maxLineLength - (label.size() + searchLength + 3));
+    return {label, {searchPattern, searchLength}, "': "sv, entry};
+}
+
+void CLIBase::finishSearch(bool accept) {
+    const LineView oldView = searchView();
+    const uint16_t match = searchMatches[searchLength];
+    searching = false;
+    if (accept && match != noMatch) {
+        // edited line is kept, so it can be reached with down arrow
+        if (!historyShown) line[length] = 0;
+        historyShown = true;
+        shownEntry = match;
+        length = history[match].size();
+    }
+    redrawView(oldView, LineView(std::string_view(shownLine(), length)));
 }
 
-void CLI::processBuffer() {
+void CLIBase::processBuffer() {
     if (length != 0) {
-        auto buf = std::string_view(dataBuffer[activeBuffer], length);
-        auto command = buf;
-        std::string_view parameters{};
-        if (auto pos = buf.find(' '); pos != buf.npos) {
-            command = buf.substr(0, pos);
-            parameters = buf.substr(pos + 1);
-        }
-        menu.processCommand(command, parameters);
-        activeBuffer = (activeBuffer + 1) % BUFFERLENGTH;
+        const auto commandLine = std::string_view(line, length);
+        line[length] = '\0';
+        history.push(commandLine);
+        const auto result = menu.processCommand(commandLine);
         length = 0;
-        dataBuffer[activeBuffer][0] = '\0';
-        previousBuffer = activeBuffer;
+        if (result.status == MainMenuBase::Result::Status::Started) {
+            cursor = 0;
+            // prompt is drawn when command finishes, coroutine is resumed by readInput
+            if (!menu.task) {
+                // everything written so far has to reach console before output of command running in other context
+                output.flush();
+                menu.startJob(port);
+            }
+            return;
+        }
     }
+    cursor = 0;
     drawPrompt();
 }
 
-void CLI::init() {
-    // clear buffer
-    for (uint32_t index = 0; index < BUFFERLENGTH; index++) {
-        dataBuffer[index][0] = '\0';
+void CLIBase::addTypeahead(std::string_view input) {
+    for (char sign : input) {
+        /* Ctrl-C, or any key when watch runs */
+        if (sign == 3 || menu.watching) {
+            menu.cancellation.request();
+        } else if (typeaheadLength < sizeof(typeahead)) {
+            typeahead[typeaheadLength++] = sign;
+        }
     }
+}
 
-    // draw prompt on screen
-    drawPrompt();
+void CLIBase::resumeTask(CommandTask::Clock::time_point now) {
+    using Wait = CommandTask::Wait;
+    CommandTask &task = menu.task;
+    bool resumed = false;
+    bool flushed = false;
+    while (!task.done()) {
+        const Wait &wait = task.wait();
+        switch (wait.kind) {
+            case Wait::Kind::Nothing:
+                break;
+            case Wait::Kind::Output:
+                if (output.available() < std::min(wait.bytes, output.capacity())) {
+                    // one buffer per poll, so input is handled between chunks of long output
+                    if (flushed) return;
+                    output.flush();
+                    flushed = true;
+                }
+                break;
+            case Wait::Kind::Time:
+                // command that sleeps again gives control back too, so it can't hold console when its period is short
+                if (!menu.cancellation.requested() && (resumed || now < wait.until)) return;
+                break;
+            case Wait::Kind::Poll:
+                if (resumed) return;
+                break;
+        }
+        task.resume();
+        resumed = true;
+    }
 }
 
-void CLI::showCommands() {
-    const auto buf = std::string_view(dataBuffer[activeBuffer], length);
-    auto command = buf;
-    if (auto pos = buf.find(' '); pos != buf.npos) {
-        command = buf.substr(0, pos);
-    }
-    /* Last word is containing the sentence that should be complemented */
-    std::string_view ret = menu.showCommands(command);
-    if (ret.size() > 0) {
-        /* ret number of letters were appended */
-        const uint16_t spaceInBuffer = LINELENGTH - length;
-        if (ret.size() < spaceInBuffer) {
-            ret.copy(&dataBuffer[activeBuffer][buf.size()], ret.size());
-            /* Clearing current line */
-            cleanLine(length);
-            length += ret.size();
-            dataBuffer[activeBuffer][length] = 0;
+bool CLIBase::commandFinished() const noexcept {
+    return menu.job.finished() || (menu.task && menu.task.done());
+}
+
+void CLIBase::finishCommand() {
+    while (commandFinished()) {
+        if (menu.cancellation.requested() && !menu.watching) output.write("^C"sv);
+        menu.watching = false;
+        if (menu.task) {
+            menu.task = {};
         } else {
-            port.write("\n\rLine buffer overflow.\n\r"sv);
+            menu.job.state.store(CommandJob::State::Idle, std::memory_order_relaxed);
         }
-    }
-    if (ret.empty()) {
-        /* Some text has been displayed, puts new prompt and rewrite command */
         drawPrompt();
+
+        // replayed line by line, so chars after line that starts next command stay buffered
+        std::string_view pending(typeahead, typeaheadLength);
+        while (pending.size() && !menu.commandRunning()) {
+            const size_t lineEnd = std::min(pending.find_first_of("\r\n"sv), pending.size() - 1) + 1;
+            addChars(pending.substr(0, lineEnd));
+            pending.remove_prefix(lineEnd);
+        }
+        std::copy(pending.begin(), pending.end(), typeahead);
+        typeaheadLength = pending.size();
     }
-    port.write({dataBuffer[activeBuffer], length});
+}
+
+void CLIBase::setMachineMode(bool enabled) {
+    if (enabled == machineMode) return;
+    machineMode = enabled;
+    // line typed so far is dropped
+    length = 0;
+    cursor = 0;
+    historyShown = false;
+    searching = false;
+    escapeState = None;
+    previous_CR = 0;
+    requestTooLong = false;
+    if (!machineMode) menu.drawPrompt();
+    output.flush();
+}
+
+void CLIBase::addRequestChars(std::string_view input) {
+    while (input.size()) {
+        if (previous_CR) {
+            previous_CR = 0;
+            if (input.front() == '\n') input.remove_prefix(1);
+            continue;
+        }
+        const auto lineEnd = input.find_first_of("\r\n"sv);
+        const auto text = input.substr(0, lineEnd);
+        const size_t accepted = std::min<size_t>(text.size(), maxLineLength - length);
+        text.copy(&line[length], accepted);
+        length += accepted;
+        if (accepted < text.size()) requestTooLong = true;
+        if (lineEnd == input.npos) return;
+        previous_CR = input[lineEnd] == '\r';
+        input.remove_prefix(lineEnd + 1);
+        processRequest();
+    }
+}
+
+void CLIBase::processRequest() {
+    const auto request = std::string_view(line, length);
+    const auto idEnd = request.find(' ');
+    const auto commandLine = idEnd != request.npos ? request.substr(idEnd + 1) : std::string_view{};
+    if (length) {
+        frames.begin(request.substr(0, idEnd));
+        if (requestTooLong) {
+            frames.end(FrameWriterBase::LineTooLong);
+        } else {
+            line[length] = '\0';
+            // command output is packed into frames
+            menu.port = &frames;
+            const auto result = menu.processCommand(commandLine, MainMenuBase::Mode::Batch);
+            menu.port = &output;
+            if (result.status == MainMenuBase::Result::Status::NotFound) {
+                frames.end(FrameWriterBase::NotFound);
+            } else {
+                frames.end(FrameWriterBase::Executed, result.value);
+            }
+        }
+    }
+    length = 0;
+    requestTooLong = false;
+}
+
+void CLIBase::init() {
+    // from now on menu prints through the output buffer
+    menu.port = &output;
+
+    // draw prompt on screen
+    drawPrompt();
+}
+
+void CLIBase::completeCommand() {
+    const bool showCandidates = completionPending;
+    completionPending = false;
+    const auto command = std::string_view(line, length);
+    // only command name is completed, not its parameters
+    if (command.find(' ') != command.npos) return;
+
+    const auto completion = menu.complete(command);
+    if (completion.matches == 0) return;
+    if (completion.common.size() > command.size()) {
+        const auto fill = completion.common.substr(command.size());
+        if (fill.size() > static_cast<size_t>(maxLineLength - length)) return;
+        moveCursor(length);
+        insertText(fill);
+        completionPending = completion.matches > 1;
+        return;
+    }
+    if (completion.matches == 1) return;
+    if (!showCandidates) {
+        completionPending = true;
+        return;
+    }
+    menu.showCandidates(command);
+    /* Candidates have been displayed, puts new prompt and rewrite command */
+    drawPrompt();
+    output.write({line, length});
+    const uint8_t editPosition = cursor;
+    cursor = length;
+    moveCursor(editPosition);
 }
 
 }  // namespace microhal
@@ -46,49 +46,121 @@
 #define CLI_H_
 
 #include <string.h>
+#include <array>
+#include <span>
 #include "IODevice/IODevice.h"
+#include "frameWriter.h"
+#include "history.h"
 #include "mainMenu.h"
+#include "outputBuffer.h"
 
 namespace microhal {
 
 #define LINELENGTH 80
-#define BUFFERLENGTH 10
+#define HISTORYLENGTH 512
+#define OUTPUTBUFFERLENGTH 256
+#define INPUTCHUNKLENGTH 32
+#define SEARCHLENGTH 20
+#define FRAMELENGTH 64
+#define TYPEAHEADLENGTH 64
 
 /**
  * @brief Provides chars processing functionalities, buffering, etc.
  */
-class CLI {
+class CLIBase {
  public:
     /**
-     * @brief Initializes CLI device.
-     * @param port - console IODevice port.
-     * @param menu - MainMenu reference.
+     * @brief Reads all chars that are waiting in console and processes them. Should be called when console signals new data
+     *        (ex. after poll on console descriptor) or cyclically (ex. every 10ms in a thread).
+     */
+    void readInput() { readInput(CommandTask::Clock::now()); }
+    /**
+     * @brief Reads and processes chars like readInput(), sleeping coroutine command is resumed when its wake up time passed.
+     * @param now - current time.
+     */
+    void readInput(CommandTask::Clock::time_point now);
+
+    /**
+     * @brief Checks whether console has data waiting for readInput.
+     */
+    bool inputAvailable() const { return port.availableBytes() > 0; }
+    /**
+     * @brief Checks whether asynchronous or coroutine command runs. Coroutine command is resumed by readInput, so it should be
+     *        called frequently then, ex. also when console output drains or on timer tick.
      */
-    CLI(IODevice &port, MainMenuBase &menu) : port(port), menu(menu), length(0), activeBuffer(0), previousBuffer(0) { init(); }
+    bool commandRunning() const { return menu.commandRunning(); }
+
+    /**
+     * @brief Switches session between human console and machine mode. In machine mode there is no echo, prompt or line
+     *        editing. Every request line is "<request id> <command line>", responses are sent in frames described in
+     *        FrameWriterBase, so host may send many requests without waiting and match responses by request id.
+     * @param enabled - true to switch to machine mode, false to go back to human console.
+     */
+    void setMachineMode(bool enabled);
+    [[nodiscard]] bool isMachineMode() const { return machineMode; }
+
+    CLIBase(const CLIBase &) = delete;
+    CLIBase &operator=(const CLIBase &) = delete;
 
+ protected:
     /**
      * @brief Initializes CLI device.
      * @param port - console IODevice port.
      * @param menu - MainMenu reference.
-     * @param helloTxt - hello string.
+     * @param historyArena - memory for command history.
+     * @param historyState - command history state kept together with arena, nullptr when history starts empty.
      */
-    CLI(IODevice &port, MainMenuBase &menu, const char *helloTxt) : port(port), menu(menu), length(0), activeBuffer(0), previousBuffer(0) {
-        port.write(helloTxt);
+    CLIBase(IODevice &port, MainMenuBase &menu, std::span<char> historyArena, History::State *historyState)
+        : port(port),
+          output(port),
+          frames(output),
+          menu(menu),
+          history(historyArena, historyState),
+          length(0),
+          cursor(0),
+          shownEntry(0),
+          historyShown(false),
+          searching(false),
+          searchLength(0),
+          escapeState(None),
+          escapeParameter(0),
+          previous_CR(0),
+          machineMode(false),
+          requestTooLong(false),
+          completionPending(false),
+          typeaheadLength(0) {
         init();
     }
 
     /**
-     * @brief Reads chars from console and process them. Should be called cyclically (ex. every 10ms in a thread).
+     * @brief Initializes CLI device.
+     * @param port - console IODevice port.
+     * @param menu - MainMenu reference.
+     * @param historyArena - memory for command history.
+     * @param historyState - command history state kept together with arena, nullptr when history starts empty.
+     * @param helloTxt - hello string.
      */
-    void readInput() {
-        uint16_t tmpLen;
-        char tmpBuff[3];
-
-        tmpLen = port.read(tmpBuff, 3);
-
-        for (uint16_t i = 0; i < tmpLen; i++) {
-            addSign(tmpBuff[i]);
-        }
+    CLIBase(IODevice &port, MainMenuBase &menu, std::span<char> historyArena, History::State *historyState, const char *helloTxt)
+        : port(port),
+          output(port),
+          frames(output),
+          menu(menu),
+          history(historyArena, historyState),
+          length(0),
+          cursor(0),
+          shownEntry(0),
+          historyShown(false),
+          searching(false),
+          searchLength(0),
+          escapeState(None),
+          escapeParameter(0),
+          previous_CR(0),
+          machineMode(false),
+          requestTooLong(false),
+          completionPending(false),
+          typeaheadLength(0) {
+        output.write(helloTxt);
+        init();
     }
 
  private:
@@ -96,82 +168,249 @@ class CLI {
      * @brief IODevice console port.
      */
     IODevice &port;
+    /**
+     * @brief Output staging buffer, everything that CLI, MainMenu and commands print goes through it.
+     */
+    OutputBuffer<OUTPUTBUFFERLENGTH> output;
+    /**
+     * @brief Packs command output into response frames in machine mode, frames go through output buffer.
+     */
+    FrameWriter<FRAMELENGTH> frames;
     /**
      * @brief  MainMenu instance.
      */
     MainMenuBase &menu;
     /**
-     * @brief Chars buffer.
+     * @brief Line being edited.
+     */
+    char line[LINELENGTH];
+    /**
+     * @brief Previously executed commands.
      */
-    char dataBuffer[BUFFERLENGTH][LINELENGTH];
+    History history;
     /**
-     * @brief Actual line position.
+     * @brief Actual line length.
      */
     uint8_t length;
     /**
-     * @brief Current buffer indicator.
+     * @brief Cursor position in line, 0 is the beginning of line.
+     */
+    uint8_t cursor;
+    /**
+     * @brief Position of history entry shown instead of edited line.
+     */
+    uint16_t shownEntry;
+    /**
+     * @brief Set when history entry is shown, entry is copied into line when user starts to edit it.
+     */
+    bool historyShown;
+    /**
+     * @brief Set while reverse history search (Ctrl-R) is in progress.
+     */
+    bool searching;
+    /**
+     * @brief Length of searched text.
      */
-    uint8_t activeBuffer;
+    uint8_t searchLength;
     /**
-     * @brief Previous buffer indicator.
+     * @brief Searched text.
      */
-    uint8_t previousBuffer;
+    char searchPattern[SEARCHLENGTH];
+    /**
+     * @brief History entry found for every searched text length, so search resumes from last match when char is added and
+     *        returns to previous match when char is removed.
+     */
+    uint16_t searchMatches[SEARCHLENGTH + 1];
+    /**
+     * @brief Escape sequence decoding state.
+     */
+    enum EscapeState : uint8_t { None, Escape, ControlSequence, SingleShift } escapeState;
+    /**
+     * @brief Numeric parameter of control sequence, ex. 3 in ESC [ 3 ~.
+     */
+    uint8_t escapeParameter;
+    /**
+     * @brief Set after CR, so LF of CR LF pair is ignored.
+     */
+    uint8_t previous_CR;
+    /**
+     * @brief Set when session is in machine mode.
+     */
+    bool machineMode;
+    /**
+     * @brief Set when machine mode request didn't fit into line.
+     */
+    bool requestTooLong;
+    /**
+     * @brief Set after Tab that found more than one command, next Tab shows them.
+     */
+    bool completionPending;
+    /**
+     * @brief Chars typed while asynchronous command runs, replayed when it finishes.
+     */
+    char typeahead[TYPEAHEADLENGTH];
+    uint8_t typeaheadLength;
 
     /**
-     * @brief Initializes buffer.
+     * @brief Longest line that could be entered, leaves space for trailing space and NULL termination.
      */
-    void init();
+    static constexpr uint8_t maxLineLength = LINELENGTH - 2;
     /**
-     * @brief Append char to current buffer line if there is enough space. Always leaves
-     *        space for null termination which could be appended to last left byte.
-     * @param sign - char to store
-     * @return  -1 if failed, sign if succeed.
+     * @brief Marks that no history entry was found.
      */
-    inline int charAppend(char sign);
+    static constexpr uint16_t noMatch = UINT16_MAX;
+
+    struct LineView;
+
     /**
-     * @brief Delete last char in buffer. Safe deletion.
-     * @param count - are you a golfer?
-     * @return  Count of chars deleted.
+     * @brief Initializes buffer.
      */
-    inline unsigned int charDelete(unsigned int count);
+    void init();
     /**
      * @brief Draws prompt according to current path.
      */
     inline void drawPrompt();
+
     /**
-     * @brief Deletes chars from current line from console.
-     * @param count - are you a golfer?
-     * @return Number of chars deleted.
+     * @brief Processes chunk of received chars. Runs of printable chars are appended and echoed at once, control chars and
+     *        escape sequences are passed to addSign.
+     * @param input - received chars.
      */
-    inline unsigned int cleanLine(unsigned int count);
-
+    void addChars(std::string_view input);
+    /**
+     * @brief Inserts run of printable chars at cursor position and redraws changed part of line. Chars that don't fit into
+     *        line are dropped.
+     * @param text - chars without any control char.
+     */
+    void insertText(std::string_view text);
+    /**
+     * @brief Removes chars from line and redraws changed part of line.
+     * @param position - position of first removed char.
+     * @param count - number of chars to remove.
+     */
+    void eraseChars(uint8_t position, uint8_t count);
     /**
      * @brief Add and processes an added char.
      * @param sign - maybe you are a golfer?
      */
     void addSign(char sign);
     /**
-     * @brief Shows previous command from history if any. Switches current buffer.
+     * @brief Decodes escape sequences: arrows, Home, End and Delete keys.
+     * @param sign - char following ESC.
+     * @return false if char doesn't belong to escape sequence and should be processed as ordinary char.
+     */
+    bool processEscapeSequence(char sign);
+    /**
+     * @brief Moves console cursor within current line, using backspaces, reprinted chars or VT100 sequence, whichever is shorter.
+     * @param position - new cursor position.
+     */
+    void moveCursor(uint8_t position);
+    /**
+     * @brief Moves console cursor to the left using backspaces or VT100 sequence, whichever is shorter.
+     */
+    void moveCursorLeft(uint8_t count);
+    /**
+     * @brief Sends VT100 cursor movement sequence ESC [ count command.
+     */
+    void writeCursorSequence(uint8_t count, char command);
+    /**
+     * @brief Brings console in sync with line buffer when line content changed starting from given position.
+     * @param from - first position that differs from content visible on console.
+     * @param oldLength - length of line visible on console.
+     * @param newCursor - cursor position after redraw.
+     */
+    void redraw(uint8_t from, uint8_t oldLength, uint8_t newCursor);
+    /**
+     * @return Chars visible on console, edited line or shown history entry.
+     */
+    const char *shownLine() const { return historyShown ? history[shownEntry].data() : line; }
+    /**
+     * @brief Switches displayed line to history entry or back to edited line, only the part that differs from the current
+     *        line is sent.
+     * @param fromHistory - true to show history entry, false to show edited line.
+     * @param entry - position of history entry to show.
+     */
+    void replaceLine(bool fromHistory, uint16_t entry);
+    /**
+     * @brief Shows previous command from history if any.
      */
     void showPreviousCommand();
     /**
-     * @brief Shows next command from buffer, unless it isn't the last called command.
-     *        Switches current buffer.
+     * @brief Shows next command from history, or edited line after the newest command.
      */
     void showNextCommand();
     /**
-     * @brief If any command in history is edited, the buffer is switched to last entry
-     *        and the content is copied.
+     * @brief If any command from history is edited, it's content is copied into edited line.
      */
     void duplicateCommand();
     /**
-     * @brief Called when tab was clicked.
+     * @brief Replaces line visible on console, only the part that differs from old content is sent. Leaves cursor at the end
+     *        of the new line.
+     */
+    void redrawView(const LineView &oldView, const LineView &newView);
+    /**
+     * @brief Starts reverse history search, edited line is kept until the search is accepted.
+     */
+    void startSearch();
+    /**
+     * @brief Handles key pressed during reverse history search.
+     * @return false when key ended the search and should be processed as ordinary key.
+     */
+    bool processSearchKey(char sign);
+    /**
+     * @brief Searches history for entry containing searched text, starting from given entry towards older ones.
+     * @return Position of found entry or noMatch.
+     */
+    uint16_t findMatch(uint16_t from) const;
+    /**
+     * @brief Checks whether entry shown for current search text doesn't contain it.
+     */
+    bool searchFailed() const;
+    /**
+     * @brief Line shown during search: search text and found entry.
+     */
+    LineView searchView() const;
+    /**
+     * @brief Ends reverse history search.
+     * @param accept - true to show found entry as current line, false to restore line from before the search.
      */
-    void showCommands();
+    void finishSearch(bool accept);
+    /**
+     * @brief Called when tab was clicked. Fills command name with longest common prefix of matching commands, matching
+     *        commands are shown by second Tab in a row.
+     */
+    void completeCommand();
     /**
      * @brief Called when new line was clicked.
      */
     void processBuffer();
+    /**
+     * @brief Keeps chars typed while asynchronous command runs. Ctrl-C, or any key when watch runs, requests its cancellation.
+     * @param input - received chars.
+     */
+    void addTypeahead(std::string_view input);
+    /**
+     * @brief Resumes coroutine command as long as what it waits for is available, output buffer is flushed at most once.
+     * @param now - current time.
+     */
+    void resumeTask(CommandTask::Clock::time_point now);
+    /**
+     * @return true when asynchronous or coroutine command ended and console didn't process it yet.
+     */
+    bool commandFinished() const noexcept;
+    /**
+     * @brief Processes end of asynchronous or coroutine command: draws prompt and replays typed ahead chars, which may start next command.
+     */
+    void finishCommand();
+    /**
+     * @brief Collects machine mode requests, without echo and line editing.
+     * @param input - received chars.
+     */
+    void addRequestChars(std::string_view input);
+    /**
+     * @brief Executes machine mode request and sends framed response.
+     */
+    void processRequest();
 
     /**
      * @defgroup constances
@@ -184,40 +423,68 @@ class CLI {
      */
 };
 
-int CLI::charAppend(char sign) {
-    if (length < LINELENGTH - 1) {
-        dataBuffer[previousBuffer][length++] = sign;
-        return sign;
-    } else if (length < LINELENGTH && sign == 0) {
-        dataBuffer[previousBuffer][length++] = sign;
-        return 0;
-    }
-    return -1;
+void CLIBase::drawPrompt() {
+    menu.drawPrompt();
+    output.flush();
 }
 
-unsigned int CLI::charDelete(unsigned int count) {
-    unsigned int deleted = 0;
-    while (length > 0 && count != deleted) {
-        dataBuffer[previousBuffer][--length] = 0;
-        ++deleted;
-    }
-    return deleted;
-}
+/**
+ * @brief CLI with command history stored in arena of given size. Line length doesn't depend on history size, history just keeps
+ *        as many recent commands as fit into the arena.
+ */
+template <size_t historySize = HISTORYLENGTH>
+class CLI : public CLIBase {
+    static_assert(historySize <= UINT16_MAX, "History arena too big.");
 
-unsigned int CLI::cleanLine(unsigned int count) {
-    // send delete characters
-    unsigned int iter;
-    for (iter = 0; iter < count; iter++) {
-        port.putChar(del);
-        port.putChar(space);
-        port.putChar(del);
-    }
-    return iter;
-}
+ public:
+    /**
+     * @brief Initializes CLI device.
+     * @param port - console IODevice port.
+     * @param menu - MainMenu reference.
+     */
+    CLI(IODevice &port, MainMenuBase &menu) : CLIBase(port, menu, historyArena, nullptr) {}
+    /**
+     * @brief Initializes CLI device.
+     * @param port - console IODevice port.
+     * @param menu - MainMenu reference.
+     * @param helloTxt - hello string.
+     */
+    CLI(IODevice &port, MainMenuBase &menu, const char *helloTxt) : CLIBase(port, menu, historyArena, nullptr, helloTxt) {}
 
-void CLI::drawPrompt() {
-    menu.drawPrompt();
-}
+ private:
+    std::array<char, historySize> historyArena;
+};
+
+/**
+ * @brief CLI with command history kept in memory provided by user, ex. persistent history file mapped into memory:
+ *        @code
+ *        PersistentHistory historyFile("cli_history", 4096);
+ *        CLI<std::dynamic_extent> cli(port, menu, historyFile.arena(), historyFile.state());
+ *        @endcode
+ */
+template <>
+class CLI<std::dynamic_extent> : public CLIBase {
+ public:
+    /**
+     * @brief Initializes CLI device.
+     * @param port - console IODevice port.
+     * @param menu - MainMenu reference.
+     * @param historyArena - memory for command history.
+     * @param historyState - command history state kept together with arena, history that isn't valid is cleared.
+     */
+    CLI(IODevice &port, MainMenuBase &menu, std::span<char> historyArena, History::State &historyState)
+        : CLIBase(port, menu, historyArena, &historyState) {}
+    /**
+     * @brief Initializes CLI device.
+     * @param port - console IODevice port.
+     * @param menu - MainMenu reference.
+     * @param historyArena - memory for command history.
+     * @param historyState - command history state kept together with arena, history that isn't valid is cleared.
+     * @param helloTxt - hello string.
+     */
+    CLI(IODevice &port, MainMenuBase &menu, std::span<char> historyArena, History::State &historyState, const char *helloTxt)
+        : CLIBase(port, menu, historyArena, &historyState, helloTxt) {}
+};
 
 }  // namespace microhal
 
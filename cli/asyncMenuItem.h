@@ -0,0 +1,145 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Menu items that run in worker context.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_ASYNCMENUITEM_H_
+#define _CLI_ASYNCMENUITEM_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include "IODevice/IODevice.h"
+#include "menuItem.h"
+
+namespace microhal {
+
+class AsyncMenuItem;
+class CLIBase;
+class MainMenuBase;
+
+/**
+ * @brief Lets console ask running command to stop, set by Ctrl-C.
+ */
+class CancellationToken {
+ public:
+    [[nodiscard]] bool requested() const noexcept { return flag.load(std::memory_order_relaxed); }
+
+ private:
+    friend CLIBase;
+    friend MainMenuBase;
+
+    void request() noexcept { flag.store(true, std::memory_order_relaxed); }
+    void reset() noexcept { flag.store(false, std::memory_order_relaxed); }
+
+    std::atomic<bool> flag{false};
+};
+
+/**
+ * @brief Call of asynchronous command handed to CommandExecutor.
+ */
+class CommandJob {
+ public:
+    /**
+     * @brief Executes command, executor has to call it exactly once for every started job.
+     */
+    void run() noexcept;
+
+    /**
+     * @return true from start of the job until console processes its end.
+     */
+    [[nodiscard]] bool busy() const noexcept { return state.load(std::memory_order_acquire) != State::Idle; }
+    /**
+     * @return true when command returned and console didn't process its end yet.
+     */
+    [[nodiscard]] bool finished() const noexcept { return state.load(std::memory_order_acquire) == State::Finished; }
+
+ private:
+    friend CLIBase;
+    friend MainMenuBase;
+
+    enum class State : uint8_t { Idle, Prepared, Running, Finished };
+
+    AsyncMenuItem *command = nullptr;
+    std::string_view parameters{};
+    IODevice *port = nullptr;
+    const CancellationToken *token = nullptr;
+    int value = 0;
+    std::atomic<State> state{State::Idle};
+};
+
+/**
+ * @brief Runs asynchronous commands in worker context, ex. RTOS task or thread, implemented by application:
+ *        @code
+ *        class WorkerExecutor : public CommandExecutor {
+ *         public:
+ *            bool start(CommandJob &job) noexcept final { return workerQueue.tryPush(&job); }
+ *        };
+ *        // worker task: while (true) workerQueue.pop()->run();
+ *        @endcode
+ */
+class CommandExecutor {
+ public:
+    virtual ~CommandExecutor() = default;
+
+    /**
+     * @brief Hands job to worker context, which calls job.run(). Called by console, so it should return quickly.
+     * @param job - job to run.
+     * @return false when job can't be started, then it is run synchronously.
+     */
+    virtual bool start(CommandJob &job) noexcept = 0;
+};
+
+/**
+ * @brief Command that may run for a long time, ex. flash erase or self test. When menu has CommandExecutor and command is typed
+ *        on interactive console, command runs in worker context and console keeps reading input: Ctrl-C requests
+ *        cancellation and other typed chars are replayed when command finishes. In scripts and machine mode command runs
+ *        synchronously.
+ */
+class AsyncMenuItem : public MenuItem {
+ public:
+    using MenuItem::MenuItem;
+
+    /**
+     * @brief Executes command. Command output is written directly to console, long running command should check token
+     *        from time to time and return early when cancellation was requested.
+     * @param parameters - test string with command arguments.
+     * @param port - a console stream.
+     * @param token - cancellation request.
+     * @return Execution return value, non zero value marks failed command.
+     */
+    virtual int execute(std::string_view parameters, IODevice &port, const CancellationToken &token) = 0;
+
+    /**
+     * @brief Executes command synchronously, it can't be cancelled.
+     */
+    int execute(std::string_view parameters, IODevice &port) final;
+
+    AsyncMenuItem *asAsync() noexcept final { return this; }
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_ASYNCMENUITEM_H_ */
@@ -0,0 +1,84 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Menu items implemented as coroutines.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "coroutineMenuItem.h"
+#include <array>
+#include <atomic>
+
+namespace microhal {
+
+namespace {
+struct alignas(std::max_align_t) Frame {
+    char storage[COROUTINEFRAMELENGTH];
+};
+
+std::array<Frame, COROUTINEFRAMES> frames;
+std::array<std::atomic<bool>, COROUTINEFRAMES> framesUsed{};
+}  // namespace
+
+void *CommandTask::promise_type::operator new(size_t size) noexcept {
+    if (size > sizeof(Frame)) return nullptr;
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (!framesUsed[i].exchange(true, std::memory_order_acquire)) return frames[i].storage;
+    }
+    return nullptr;
+}
+
+void CommandTask::promise_type::operator delete(void *frame) noexcept {
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (frame == frames[i].storage) framesUsed[i].store(false, std::memory_order_release);
+    }
+}
+
+int CommandTask::runToCompletion() {
+    while (!done()) {
+        const auto &pending = wait();
+        const auto token = handle.promise().token;
+        if (pending.kind == Wait::Kind::Time) {
+            while (Clock::now() < pending.until && !(token && token->requested())) {
+            }
+        }
+        resume();
+    }
+    return value();
+}
+
+CommandTask CoroutineMenuItem::start(std::string_view parameters, IODevice &port, const CancellationToken &token) {
+    CommandTask task = execute(parameters, port, token);
+    if (task) task.setToken(token);
+    return task;
+}
+
+int CoroutineMenuItem::execute(std::string_view parameters, IODevice &port) {
+    const CancellationToken neverCancelled;
+    CommandTask task = start(parameters, port, neverCancelled);
+    // no free coroutine frame
+    if (!task) return -1;
+    return task.runToCompletion();
+}
+
+}  // namespace microhal
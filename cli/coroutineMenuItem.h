@@ -0,0 +1,224 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Menu items implemented as coroutines.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_COROUTINEMENUITEM_H_
+#define _CLI_COROUTINEMENUITEM_H_
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <utility>
+#include "IODevice/IODevice.h"
+#include "asyncMenuItem.h"
+#include "menuItem.h"
+
+namespace microhal {
+
+#define COROUTINEFRAMES 2
+#define COROUTINEFRAMELENGTH 512
+
+/**
+ * @brief Running CoroutineMenuItem command. Coroutine frames are taken from a pool of COROUTINEFRAMES static frames of
+ *        COROUTINEFRAMELENGTH bytes, not from heap. When there is no free frame, or frame is too small, task is empty.
+ */
+class CommandTask {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief What suspended command waits for.
+     */
+    struct Wait {
+        enum class Kind : uint8_t {
+            Nothing,  ///< command can be resumed at once
+            Output,   ///< free space for bytes in output buffer
+            Time,     ///< until given time
+            Poll      ///< next input poll
+        } kind = Kind::Nothing;
+        size_t bytes = 0;
+        Clock::time_point until{};
+    };
+
+    class promise_type {
+     public:
+        CommandTask get_return_object() noexcept { return CommandTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        static CommandTask get_return_object_on_allocation_failure() noexcept { return {}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(int result) noexcept { value = result; }
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        static void *operator new(size_t size) noexcept;
+        static void operator delete(void *frame) noexcept;
+
+     private:
+        friend CommandTask;
+
+        int value = 0;
+        Wait wait{};
+        const CancellationToken *token = nullptr;
+    };
+
+    /**
+     * @brief Awaitable returned by CoroutineMenuItem helpers, co_await yields true when command wasn't cancelled.
+     */
+    class Awaiter {
+     public:
+        explicit Awaiter(Wait wait) noexcept : wait(wait) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> suspended) noexcept {
+            handle = suspended;
+            handle.promise().wait = wait;
+        }
+        bool await_resume() const noexcept {
+            const auto token = handle.promise().token;
+            return token == nullptr || !token->requested();
+        }
+
+     private:
+        Wait wait;
+        std::coroutine_handle<promise_type> handle{};
+    };
+
+    CommandTask() noexcept = default;
+    CommandTask(CommandTask &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    CommandTask &operator=(CommandTask &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    CommandTask(const CommandTask &) = delete;
+    CommandTask &operator=(const CommandTask &) = delete;
+    ~CommandTask() { destroy(); }
+
+    explicit operator bool() const noexcept { return static_cast<bool>(handle); }
+    [[nodiscard]] bool done() const noexcept { return handle.done(); }
+    /**
+     * @return Value returned by finished command.
+     */
+    [[nodiscard]] int value() const noexcept { return handle.promise().value; }
+    /**
+     * @return What suspended command waits for.
+     */
+    [[nodiscard]] const Wait &wait() const noexcept { return handle.promise().wait; }
+
+    /**
+     * @brief Resumes command until its next suspension point.
+     */
+    void resume() {
+        handle.promise().wait = {};
+        handle.resume();
+    }
+    /**
+     * @brief Runs command to its end without giving control back, time waits are busy waits. Used when nobody can resume
+     *        command later, ex. in scripts.
+     * @return Value returned by command.
+     */
+    int runToCompletion();
+
+ private:
+    friend class CoroutineMenuItem;
+
+    explicit CommandTask(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+    void setToken(const CancellationToken &token) noexcept { handle.promise().token = &token; }
+
+    void destroy() noexcept {
+        if (handle) handle.destroy();
+        handle = {};
+    }
+
+    std::coroutine_handle<promise_type> handle{};
+};
+
+/**
+ * @brief Command implemented as C++20 coroutine, ex. dump or listing with a lot of output. On interactive console it is resumed
+ *        by CLI between input polls, so output streams at link speed while input is handled, Ctrl-C requests cancellation.
+ *        In scripts and machine mode it runs to completion at once.
+ *        @code
+ *        CommandTask execute(std::string_view parameters, IODevice &port, const CancellationToken &token) final {
+ *            for (const auto &record : records) {
+ *                if (!co_await writable(recordLength)) co_return 1;
+ *                port.write(format(record));
+ *            }
+ *            co_return 0;
+ *        }
+ *        @endcode
+ */
+class CoroutineMenuItem : public MenuItem {
+ public:
+    using MenuItem::MenuItem;
+
+    /**
+     * @brief Starts command, it runs when task is resumed. Parameters stay valid until command ends.
+     * @param parameters - test string with command arguments.
+     * @param port - a console stream.
+     * @param token - cancellation request.
+     * @return Command task, co_return value is execution return value.
+     */
+    virtual CommandTask execute(std::string_view parameters, IODevice &port, const CancellationToken &token) = 0;
+
+    /**
+     * @brief Executes command synchronously, it can't be cancelled.
+     */
+    int execute(std::string_view parameters, IODevice &port) final;
+
+    CoroutineMenuItem *asCoroutine() noexcept final { return this; }
+
+    /**
+     * @brief Starts command with given cancellation token.
+     * @return Command task, empty when there was no free coroutine frame.
+     */
+    CommandTask start(std::string_view parameters, IODevice &port, const CancellationToken &token);
+
+ protected:
+    /**
+     * @brief Suspends command until output buffer has space for given bytes count.
+     */
+    static CommandTask::Awaiter writable(size_t bytes) noexcept {
+        return CommandTask::Awaiter({CommandTask::Wait::Kind::Output, bytes, {}});
+    }
+    /**
+     * @brief Suspends command for given time, cancellation ends it early.
+     */
+    static CommandTask::Awaiter sleep(CommandTask::Clock::duration duration) noexcept {
+        return CommandTask::Awaiter({CommandTask::Wait::Kind::Time, 0, CommandTask::Clock::now() + duration});
+    }
+    /**
+     * @brief Suspends command until next input poll.
+     */
+    static CommandTask::Awaiter yield() noexcept { return CommandTask::Awaiter({CommandTask::Wait::Kind::Poll, 0, {}}); }
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_COROUTINEMENUITEM_H_ */
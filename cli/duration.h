@@ -1,21 +1,19 @@
 /**
  * @license    BSD 3-Clause
- * @copyright  microHAL
+ * @copyright  Pawel Okas
  * @version    $Id$
- * @brief    Example of a project that incorporates CLI module.
+ * @brief      Duration given as command parameter.
  *
- * @authors    Kubaszek Mateusz <mathir.km.microhal@gmail.com>
- * created on: <23-01-2016>
- * last modification: <24-01-2016>
+ * @authors    Pawel Okas
  *
- * @copyright Copyright (c) 2015, microHAL
+ * @copyright Copyright (c) 2021, Pawel Okas
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
  *
  *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
- *        2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
- *           documentation and/or other materials provided with the distribution.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
  *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
  *        software without specific prior written permission.
  *
@@ -27,48 +25,22 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-/**
- * @defgroup microHAL
- * @{
- */
-
-/**
- * @defgroup components
- * @{
- */
-
-/**
- * @defgroup cli
- * @{
- */
+#ifndef _CLI_DURATION_H_
+#define _CLI_DURATION_H_
 
-#include "menuItem.h"
-#include "microhal.h"
+#include <chrono>
+#include <string_view>
 
 namespace microhal {
 
-bool MenuItem::command(std::string_view command, std::string_view parameters, IODevice& port) {
-    if (command == name) {
-        port.write("\n\r");
-        execute(parameters, port);
-        return true;
-    }
-    return false;
-}
-
-}  // namespace microhal
-
 /**
- * example
- * @}
+ * @brief Parses duration given as number followed by `ms`, `s`, `min` or `h` unit, number without unit is given in seconds:
+ *        `500ms`, `10s`, `10`.
+ * @param text - duration text.
+ * @return Duration, zero when text is malformed.
  */
+std::chrono::milliseconds parseDuration(std::string_view text) noexcept;
 
-/**
- * cli
- * @}
- */
+}  // namespace microhal
 
-/**
- * components
- * @}
- */
+#endif /* _CLI_DURATION_H_ */
@@ -0,0 +1,65 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Framing of command responses for machine mode of CLI.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "frameWriter.h"
+#include <algorithm>
+#include <charconv>
+
+using namespace std::literals;
+
+namespace microhal {
+
+ssize_t FrameWriterBase::write(const char *data, size_t length) noexcept {
+    size_t written = 0;
+    while (written < length) {
+        if (used == buffer.size()) sendFrame(Partial, 0);
+        const size_t chunk = std::min(length - written, buffer.size() - used);
+        std::copy_n(&data[written], chunk, &buffer[used]);
+        used += chunk;
+        written += chunk;
+    }
+    return written;
+}
+
+void FrameWriterBase::sendFrame(Status status, int value) noexcept {
+    // "<id> <status> <value> <length>\n"
+    char header[1 + 1 + 1 + 11 + 1 + 20 + 1];
+    char *end = header;
+    *end++ = ' ';
+    *end++ = static_cast<char>('0' + status);
+    *end++ = ' ';
+    end = std::to_chars(end, end + 11, value).ptr;
+    *end++ = ' ';
+    end = std::to_chars(end, end + 20, used).ptr;
+    *end++ = '\n';
+    port.write(requestId);
+    port.write(header, end - header);
+    port.write(buffer.data(), used);
+    used = 0;
+}
+
+}  // namespace microhal
@@ -0,0 +1,116 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Framing of command responses for machine mode of CLI.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_FRAMEWRITER_H_
+#define _CLI_FRAMEWRITER_H_
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include "IODevice/IODevice.h"
+
+namespace microhal {
+
+/**
+ * @brief IODevice adapter that packs command output into frames:
+ *        @code
+ *        <request id> <status> <value> <length>\n<length bytes of output>
+ *        @endcode
+ *        Output that doesn't fit into the buffer is sent in several frames with the same request id, all but the last one have
+ *        status Partial. The last frame carries protocol status and, for executed command, value returned by
+ *        MenuItem::execute, its payload may be empty.
+ */
+class FrameWriterBase : public IODevice {
+ public:
+    /**
+     * @brief Protocol level statuses, they are sent in separate field than command value, so any value returned by
+     *        MenuItem::execute can be told apart from them.
+     */
+    enum Status : int {
+        Executed = 0,     ///< command was executed, value field holds its result
+        NotFound = 1,     ///< there is no such command in active sub menu
+        LineTooLong = 2,  ///< request didn't fit into line buffer
+        Partial = 3       ///< more frames of the same response follow
+    };
+
+    using IODevice::write;
+
+    int open(OpenMode mode) noexcept final { return port.open(mode); }
+    void close() noexcept final { port.close(); }
+    int isOpen() const noexcept final { return port.isOpen(); }
+
+    ssize_t read(char *buffer, size_t length) noexcept final { return port.read(buffer, length); }
+    ssize_t availableBytes() const noexcept final { return port.availableBytes(); }
+
+    /**
+     * @brief Collects command output, full buffer is sent as Partial frame.
+     * @return Number of bytes accepted.
+     */
+    ssize_t write(const char *data, size_t length) noexcept final;
+
+    /**
+     * @brief Starts response to request with given id.
+     * @param id - request id, has to stay valid until end() is called.
+     */
+    void begin(std::string_view id) noexcept {
+        requestId = id;
+        used = 0;
+    }
+    /**
+     * @brief Sends last frame of response.
+     * @param value - value returned by executed command, 0 for other statuses.
+     */
+    void end(Status status, int value = 0) noexcept { sendFrame(status, value); }
+
+    FrameWriterBase(const FrameWriterBase &) = delete;
+    FrameWriterBase &operator=(const FrameWriterBase &) = delete;
+
+ protected:
+    FrameWriterBase(IODevice &port, std::span<char> buffer) noexcept : port(port), buffer(buffer) {}
+
+ private:
+    IODevice &port;
+    std::span<char> buffer;
+    size_t used = 0;
+    std::string_view requestId{};
+
+    void sendFrame(Status status, int value) noexcept;
+};
+
+template <size_t size>
+class FrameWriter : public FrameWriterBase {
+ public:
+    explicit FrameWriter(IODevice &port) noexcept : FrameWriterBase(port, storage) {}
+
+ private:
+    std::array<char, size> storage;
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_FRAMEWRITER_H_ */
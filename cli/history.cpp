@@ -0,0 +1,97 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Command history kept as variable-length entries in a single ring arena.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "history.h"
+#include <algorithm>
+
+namespace microhal {
+
+bool History::push(std::string_view entry) noexcept {
+    const size_t size = entry.size() + 2;
+    if (entry.empty() || entry.size() > maxEntryLength || size > arena.size()) return false;
+    // consecutive duplicates are collapsed
+    if (state.count && (*this)[state.last] == entry) return true;
+
+    size_t position = state.count ? state.end : 0;
+    // free space lies between the newest and the oldest entry
+    while (state.count && wrapped() && position + size > state.first) dropOldest();
+    if (!wrapped() && position + size > arena.size()) {
+        // entry doesn't fit before arena end, start again from the beginning
+        state.wrap = position;
+        position = 0;
+        while (state.count && state.first < size) dropOldest();
+    }
+
+    arena[position] = static_cast<char>(entry.size());
+    std::copy(entry.begin(), entry.end(), &arena[position + 1]);
+    arena[position + size - 1] = static_cast<char>(entry.size());
+    if (state.count == 0) state.first = position;
+    state.last = position;
+    state.end = position + size;
+    state.count++;
+    return true;
+}
+
+uint16_t History::older(uint16_t position) const noexcept {
+    const uint16_t previousEnd = (position == 0 && wrapped()) ? state.wrap : position;
+    return previousEnd - (static_cast<uint8_t>(arena[previousEnd - 1]) + 2);
+}
+
+uint16_t History::newer(uint16_t position) const noexcept {
+    const uint16_t next = position + entrySize(position);
+    return (next == state.wrap && wrapped()) ? 0 : next;
+}
+
+void History::dropOldest() noexcept {
+    if (--state.count) state.first = newer(state.first);
+}
+
+bool History::isConsistent() const noexcept {
+    if (state.count == 0) return true;
+    if (state.first >= arena.size() || state.last >= arena.size() || state.end > arena.size()) return false;
+    // wrapped entries occupy [first, wrap) and [0, end)
+    if (wrapped() && (state.wrap > arena.size() || state.end > state.first)) return false;
+
+    const size_t regionEnd = wrapped() ? state.wrap : arena.size();
+    bool afterWrap = false;
+    size_t position = state.first;
+    for (size_t entries = 1;; entries++) {
+        if (position + 2 > arena.size() || arena[position] == 0) return false;
+        const size_t entryEnd = position + entrySize(position);
+        if (entryEnd > (afterWrap ? state.first : regionEnd) || arena[entryEnd - 1] != arena[position]) return false;
+        if (position == state.last) return entryEnd == state.end && entries == state.count;
+        if (entries == state.count) return false;
+        position = entryEnd;
+        if (wrapped() && position == state.wrap) {
+            if (afterWrap) return false;
+            afterWrap = true;
+            position = 0;
+        }
+    }
+}
+
+}  // namespace microhal
@@ -0,0 +1,144 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Command history kept as variable-length entries in a single ring arena.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_HISTORY_H_
+#define _CLI_HISTORY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace microhal {
+
+/**
+ * @brief Command history packed into one ring arena. Every entry is stored as length byte, entry chars and length byte again,
+ *        so it takes only 2 bytes more than the command itself and history can be walked in both directions. Entries never
+ *        wrap around the arena end, when entry doesn't fit before the end it is placed at the arena beginning. Oldest entries
+ *        are dropped when there is no space for a new one.
+ *
+ *        Entries are identified by their position in the arena, position stays valid until the entry is dropped.
+ *
+ *        Ring state may be kept outside of History object, together with the arena, so history placed in persistent memory
+ *        (ex. memory-mapped file) is used directly, without rebuilding it at startup.
+ */
+class History {
+ public:
+    /**
+     * @brief Ring state, plain data so it can be stored together with the arena.
+     */
+    struct State {
+        uint16_t first;
+        uint16_t last;
+        /**
+         * @brief Position just after the newest entry.
+         */
+        uint16_t end;
+        /**
+         * @brief Position just after the last entry placed before arena end, meaningful only when entries wrapped around.
+         */
+        uint16_t wrap;
+        uint16_t count;
+    };
+
+    /**
+     * @brief Longest entry that could be stored, limited by the length byte.
+     */
+    static constexpr size_t maxEntryLength = UINT8_MAX;
+
+    /**
+     * @param arena - memory for entries, only first 64kB are used.
+     * @param externalState - ring state kept with the arena, or nullptr if history starts empty. When external state doesn't
+     *        describe valid entries (ex. persistent memory got corrupted) history is cleared.
+     */
+    explicit History(std::span<char> arena, State *externalState = nullptr) noexcept
+        : arena(arena.first(std::min<size_t>(arena.size(), UINT16_MAX))), state(externalState ? *externalState : ownState) {
+        if (!isConsistent()) clear();
+    }
+
+    History(const History &) = delete;
+    History &operator=(const History &) = delete;
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear() noexcept { state = {}; }
+    /**
+     * @brief Appends entry as the newest one, oldest entries are dropped when there is not enough space. Entry equal to the
+     *        newest one is not stored again.
+     * @return false if entry is empty or too long to be stored.
+     */
+    bool push(std::string_view entry) noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return state.count == 0; }
+    /**
+     * @return Number of stored entries.
+     */
+    [[nodiscard]] size_t size() const noexcept { return state.count; }
+    /**
+     * @return Arena size in bytes.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return arena.size(); }
+
+    /**
+     * @brief Positions of the oldest and the newest entry, valid only when history isn't empty.
+     */
+    [[nodiscard]] uint16_t oldest() const noexcept { return state.first; }
+    [[nodiscard]] uint16_t newest() const noexcept { return state.last; }
+    /**
+     * @return Position of entry stored before entry at given position. Position mustn't be oldest().
+     */
+    [[nodiscard]] uint16_t older(uint16_t position) const noexcept;
+    /**
+     * @return Position of entry stored after entry at given position. Position mustn't be newest().
+     */
+    [[nodiscard]] uint16_t newer(uint16_t position) const noexcept;
+    /**
+     * @return Entry stored at given position, chars are contiguous in the arena.
+     */
+    [[nodiscard]] std::string_view operator[](uint16_t position) const noexcept {
+        return {&arena[position + 1], static_cast<uint8_t>(arena[position])};
+    }
+
+ private:
+    std::span<char> arena;
+    State ownState{};
+    State &state;
+
+    [[nodiscard]] bool wrapped() const noexcept { return state.last < state.first; }
+    /**
+     * @brief Walks all entries and checks that they match ring state.
+     */
+    [[nodiscard]] bool isConsistent() const noexcept;
+    [[nodiscard]] uint16_t entrySize(uint16_t position) const noexcept { return static_cast<uint8_t>(arena[position]) + 2; }
+    void dropOldest() noexcept;
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_HISTORY_H_ */
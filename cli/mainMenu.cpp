@@ -43,108 +43,238 @@
  */
 
 #include "mainMenu.h"
+#include <algorithm>
 #include <string_view>
+#include <utility>
 #include "IODevice/IODevice.h"
+#include "watch.h"
 
 using namespace std::literals;
 
 namespace microhal {
 void MainMenuBase::goBack(int count) {
-    for (int c = 0; c < count; ++c) {
-        if (activeMenu.size() > 1) {
-            activeMenu.pop_back();
-        } else
-            break;
+    if (count > 0) setDepth(std::max(1, depth - count));
+}
+
+MainMenuBase::Result MainMenuBase::processCommand(std::string_view commandLine, Mode mode) {
+    const auto command = commandLine.substr(0, commandLine.find(' '));
+    if (command.empty()) return {Result::Status::Empty, 0};
+
+    if ("exit"sv == command) {
+        /* Returning to root folder */
+        setDepth(1);
+        return {Result::Status::MenuChanged, 0};
+    }
+    if (".."sv == command) {
+        /* Switching menu */
+        if (depth > 1) setDepth(depth - 1);
+        return {Result::Status::MenuChanged, 0};
+    }
+    if ("ls"sv == command) {
+        showCommands();
+        return {Result::Status::Executed, 0};
+    }
+    if (watch && "watch"sv == command) {
+        // watch runs until key is pressed, so there is nothing to watch in scripts
+        if (mode != Mode::Interactive) return {Result::Status::Executed, -1};
+        const auto result = execute(*watch, commandLine.substr(std::min(command.size() + 1, commandLine.size())), mode);
+        watching = result.status == Result::Status::Started;
+        return result;
     }
+
+    if (const CachedPath* cached = findCachedPath(commandLine)) {
+        const auto parameters = commandLine.substr(std::min<size_t>(cached->length + 1, commandLine.size()));
+        return execute(*cached->command, parameters, mode);
+    }
+    return processPath(commandLine, mode);
 }
 
-void MainMenuBase::processCommand(std::string_view command, std::string_view parameters) {
-    SubMenuBase* activeSubMenu;
+MainMenuBase::Result MainMenuBase::processPath(std::string_view commandLine, Mode mode) {
+    // path is resolved on copy of current position, so executed command doesn't change it
+    auto menus = activeMenu;
+    uint8_t level = depth;
+    size_t position = 0;
+    if (commandLine.starts_with('/')) {
+        level = 1;
+        position = 1;
+    }
+    const SubMenuBase* const from = position ? nullptr : menus[level - 1];
+    const SubMenuBase* subMenu = menus[level - 1];
+    // path went through more sub-folders than active position can hold, it may lead to command only
+    bool tooDeep = false;
 
-    if (command.size()) {
-        /* Searching the tree, getting words from string */
-        activeSubMenu = activeMenu.back();
-        /* SubMenu branches searching */
+    while (true) {
+        const size_t wordEnd = std::min(commandLine.find_first_of(" /"sv, position), commandLine.size());
+        const MenuEntry* entry = subMenu->find(commandLine.substr(position, wordEnd - position));
+        if (entry == nullptr) return notFound(mode);
 
-        if ("exit"sv == command) {
-            /* Returning to root folder */
-            while (activeMenu.size() > 1)
-                activeMenu.pop_back();
-            return;
-        }
-        if (".."sv == command) {
-            /* Switching menu */
-            if (activeMenu.size() > 1) activeMenu.pop_back();
-            return;
-        }
-        if ("ls"sv == command) {
-            showCommands({});
-            return;
+        if (!entry->isSubMenu()) {
+            // command name may be followed only by parameters
+            if (wordEnd < commandLine.size() && commandLine[wordEnd] == '/') return notFound(mode);
+            if (position > 0) cachePath(from, commandLine.substr(0, wordEnd), entry->command());
+            return execute(entry->command(), commandLine.substr(std::min(wordEnd + 1, commandLine.size())), mode);
         }
 
-        int visitedFolders = 0;
-        bool commandFound = false;
-        for (auto it = activeSubMenu->items.begin(); it != activeSubMenu->items.end(); ++it) {
-            if ((*it)->command(command, parameters, port)) {
-                if ((*it)->hasChildrens()) {
-                    ++visitedFolders;
-                    activeMenu.push_back(static_cast<SubMenuBase*>(*it));
-                }
-                commandFound = true;
-                break;
-            }
+        subMenu = &entry->subMenu();
+        if (level < MENUDEPTH) {
+            menus[level++] = subMenu;
+        } else {
+            tooDeep = true;
         }
-        if (commandFound == false) {
-            port.write("\n\r\tno such command..."sv);
-            goBack(visitedFolders);
-            return;
+        position = wordEnd + 1;
+        if (position >= commandLine.size()) {
+            if (tooDeep) {
+                if (mode == Mode::Interactive) port->write("\n\r\tsub-folder too deep..."sv);
+                return {Result::Status::NotFound, 0};
+            }
+            /* Path ends at sub-folder, switching menu */
+            if (mode == Mode::Interactive) port->write("\n\r"sv);
+            activeMenu = menus;
+            setDepth(level);
+            return {Result::Status::MenuChanged, 0};
         }
     }
 }
 
-std::string_view MainMenuBase::showCommands(std::string_view command) {
-    SubMenuBase* pSubMenu = activeMenu.back();
-    /* Just show commands */
-    if (command.empty()) {
-        for (auto it = pSubMenu->items.begin(); it != pSubMenu->items.end(); ++it) {
-            port.write("\n\r\t"sv);
-            port.write((*it)->name);
-        }
-        return {};
-    }
-    /* Processing and appending letters, pSubMenu is the current subfolder */
-    /* Counting how many candidates has the same prefix */
-    int samePrefixCnt = 0;
-    for (auto it = pSubMenu->items.begin(); it != pSubMenu->items.end(); it++) {
-        if ((*it)->name.starts_with(command)) {
-            ++samePrefixCnt;
+MainMenuBase::FoundCommand MainMenuBase::findCommand(std::string_view commandLine) const noexcept {
+    if (const CachedPath* cached = findCachedPath(commandLine)) {
+        return {cached->command, commandLine.substr(std::min<size_t>(cached->length + 1, commandLine.size()))};
+    }
+    size_t position = commandLine.starts_with('/') ? 1 : 0;
+    const SubMenuBase* subMenu = position ? activeMenu[0] : activeMenu[depth - 1];
+    while (position < commandLine.size()) {
+        const size_t wordEnd = std::min(commandLine.find_first_of(" /"sv, position), commandLine.size());
+        const MenuEntry* entry = subMenu->find(commandLine.substr(position, wordEnd - position));
+        if (entry == nullptr) break;
+        if (!entry->isSubMenu()) {
+            if (wordEnd < commandLine.size() && commandLine[wordEnd] == '/') break;
+            return {&entry->command(), commandLine.substr(std::min(wordEnd + 1, commandLine.size()))};
         }
+        subMenu = &entry->subMenu();
+        position = wordEnd + 1;
     }
-    /* Show candidates with the same prefix */
-    for (auto it = pSubMenu->items.begin(); it != pSubMenu->items.end(); ++it) {
-        if ((*it)->name.starts_with(command)) {
-            if (1 == samePrefixCnt) {
-                /* Append letters */
-                return (*it)->name.substr(command.size());
-            } else if (samePrefixCnt > 1) {
-                port.write("\n\r\t\t "sv);
-                port.write((*it)->name);
-            }
+    return {nullptr, {}};
+}
+
+MainMenuBase::Result MainMenuBase::execute(MenuItem& command, std::string_view parameters, Mode mode) {
+    if (mode == Mode::Interactive) port->write("\n\r"sv);
+    if (AsyncMenuItem* async = command.asAsync(); async && executor && mode == Mode::Interactive) {
+        job.command = async;
+        job.parameters = parameters;
+        job.token = &cancellation;
+        cancellation.reset();
+        job.state.store(CommandJob::State::Prepared, std::memory_order_relaxed);
+        return {Result::Status::Started, 0};
+    }
+    if (CoroutineMenuItem* coroutine = command.asCoroutine()) {
+        cancellation.reset();
+        CommandTask started = coroutine->start(parameters, *port, cancellation);
+        // no free coroutine frame
+        if (!started) return {Result::Status::Executed, -1};
+        if (mode == Mode::Interactive) {
+            task = std::move(started);
+            return {Result::Status::Started, 0};
         }
+        return {Result::Status::Executed, started.runToCompletion()};
     }
-    return {};
+    return {Result::Status::Executed, command.execute(parameters, *port)};
+}
+
+MainMenuBase::Result MainMenuBase::processWatched(std::string_view commandLine, IODevice& output) {
+    IODevice* const console = port;
+    const auto menus = activeMenu;
+    const uint8_t level = depth;
+    port = &output;
+    const Result result = processCommand(commandLine, Mode::Batch);
+    port = console;
+    if (result.status == Result::Status::MenuChanged) {
+        activeMenu = menus;
+        setDepth(level);
+    }
+    return result;
+}
+
+void MainMenuBase::setWatch(WatchBase* watchCommand) noexcept {
+    watch = watchCommand;
+    if (watch) watch->menu = this;
+}
+
+void MainMenuBase::startJob(IODevice& jobPort) noexcept {
+    job.port = &jobPort;
+    job.state.store(CommandJob::State::Running, std::memory_order_release);
+    if (!executor->start(job)) job.run();
+}
+
+MainMenuBase::Result MainMenuBase::notFound(Mode mode) {
+    if (mode == Mode::Interactive) port->write("\n\r\tno such command..."sv);
+    return {Result::Status::NotFound, 0};
+}
+
+const MainMenuBase::CachedPath* MainMenuBase::findCachedPath(std::string_view commandLine) const noexcept {
+    for (const CachedPath& cached : pathCache) {
+        if (cached.command == nullptr || (cached.from != nullptr && cached.from != activeMenu[depth - 1])) continue;
+        const auto path = cached.text();
+        if (commandLine.starts_with(path) && (commandLine.size() == path.size() || commandLine[path.size()] == ' ')) return &cached;
+    }
+    return nullptr;
+}
+
+void MainMenuBase::cachePath(const SubMenuBase* from, std::string_view path, MenuItem& command) noexcept {
+    if constexpr (PATHCACHESIZE > 0) {
+        if (path.size() > PATHCACHELENGTH) return;
+        CachedPath& cached = pathCache[nextCachedPath];
+        nextCachedPath = (nextCachedPath + 1) % PATHCACHESIZE;
+        cached.from = from;
+        cached.command = &command;
+        cached.length = path.size();
+        path.copy(cached.path, path.size());
+    }
+}
+
+void MainMenuBase::showCommands() {
+    for (const MenuEntry& entry : activeMenu[depth - 1]->items) {
+        port->write("\n\r\t"sv);
+        port->write(entry.name());
+    }
+}
+
+void MainMenuBase::showCandidates(std::string_view prefix) {
+    activeMenu[depth - 1]->forEachMatching(prefix, [this](const MenuEntry& entry) {
+        port->write("\n\r\t"sv);
+        port->write(entry.name());
+    });
+}
+
+bool MainMenuBase::renderPrompt() noexcept {
+    size_t length = 0;
+    const auto append = [&](std::string_view text) {
+        if (length + text.size() > sizeof(prompt)) return false;
+        length += text.copy(&prompt[length], text.size());
+        return true;
+    };
+
+    bool fits = append("\n\r"sv);
+    for (uint_fast8_t i = 1; i < depth && fits; ++i) {
+        fits = append("> "sv) && append(activeMenu[i]->name) && append(" "sv);
+    }
+    fits = fits && append("> "sv);
+    promptLength = fits ? length : 0;
+    return fits;
 }
 
 void MainMenuBase::drawPrompt() {
-    port.write("\n\r"sv);
-    auto it = activeMenu.begin();
-    ++it;
-    for (; it != activeMenu.end(); ++it) {
-        port.write("> "sv);
-        port.write((*it)->name);
-        port.write(" "sv);
-    }
-    port.write("> "sv);
+    if (promptLength || renderPrompt()) {
+        port->write(prompt, promptLength);
+        return;
+    }
+    // prompt too long for buffer, written in parts
+    port->write("\n\r"sv);
+    for (uint_fast8_t i = 1; i < depth; ++i) {
+        port->write("> "sv);
+        port->write(activeMenu[i]->name);
+        port->write(" "sv);
+    }
+    port->write("> "sv);
 }
 
 }  // namespace microhal
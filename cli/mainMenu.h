@@ -47,11 +47,20 @@
 
 #include <array>
 #include <cstdint>
+#include "asyncMenuItem.h"
+#include "coroutineMenuItem.h"
 #include "menuItem.h"
 #include "subMenu.h"
 
 namespace microhal {
-class CLI;
+
+#define MENUDEPTH 8
+#define PATHCACHESIZE 4
+#define PATHCACHELENGTH 32
+#define PROMPTLENGTH 64
+
+class CLIBase;
+class WatchBase;
 
 /**
  * @brief Processes the text given by CLI. Implemented functions for moving through the
@@ -59,24 +68,208 @@ class CLI;
  */
 
 class MainMenuBase {
-    friend CLI;
+    friend CLIBase;
+    friend WatchBase;
+
+ public:
+    /**
+     * @brief Command line processing mode.
+     */
+    enum class Mode : uint8_t {
+        Interactive,  ///< command output starts in new line, errors are printed
+        Batch         ///< nothing but command output is printed, errors are reported only by returned result
+    };
+
+    /**
+     * @brief Outcome of processed command line.
+     */
+    struct Result {
+        enum class Status : uint8_t {
+            Empty,        ///< nothing to process
+            Executed,     ///< command was executed, value holds MenuItem::execute return value
+            MenuChanged,  ///< active sub menu was changed
+            NotFound,     ///< there is no such command in active sub menu, or sub-folder is nested deeper than MENUDEPTH
+            LineTooLong,  ///< line didn't fit into line buffer of its reader, it wasn't processed
+            Started       ///< asynchronous or coroutine command was handed to console, which runs it
+        } status;
+        int value;
+
+        /**
+         * @brief Command that wasn't found, or returned non zero value (ex. cli::Status cast to int) is treated as failed.
+         */
+        [[nodiscard]] constexpr bool failed() const noexcept { return status == Status::NotFound || status == Status::LineTooLong || value != 0; }
+    };
+
+    /**
+     * @brief Creates a menu.
+     * @param port - IODevice console port.
+     */
+    constexpr MainMenuBase(IODevice& port, const SubMenuBase& base) noexcept
+        : port(&port), activeMenu{&base}, depth(1), pathCache{}, nextCachedPath(0), prompt{}, promptLength(0) {}
+
+    /**
+     * @brief Splits command line into command and parameters and processes it. Command may be given as path to command in
+     *        nested sub-folders, words separated by space or slash, path starting with slash is resolved from root folder:
+     *        `clock alarm on`, `/clock/set -s 5`. Command found this way is executed without changing active sub-folder,
+     *        path that ends at sub-folder makes it active. Built-in commands: `exit`, `..`, `ls` and, on interactive
+     *        console, `watch <interval> <command>` when watch command was given with setWatch.
+     * @param commandLine - command followed by its parameters, separated by space.
+     * @param mode - processing mode.
+     */
+    Result processCommand(std::string_view commandLine, Mode mode = Mode::Interactive);
+
+    /**
+     * @brief Command found by findCommand.
+     */
+    struct FoundCommand {
+        MenuItem* command;  ///< nullptr when path doesn't lead to command
+        std::string_view parameters;
+    };
+
+    /**
+     * @brief Finds command given by path the way processCommand does, without executing it.
+     * @param commandLine - path to command followed by its parameters.
+     * @return Found command and its parameters.
+     */
+    FoundCommand findCommand(std::string_view commandLine) const noexcept;
+
+    /**
+     * @brief Sets executor for AsyncMenuItem commands typed on interactive console. Without executor they run synchronously.
+     * @param commandExecutor - executor or nullptr.
+     */
+    void setExecutor(CommandExecutor* commandExecutor) noexcept { executor = commandExecutor; }
+
+    /**
+     * @brief Enables built-in watch command. Without it `watch` is looked up in the menu tree like any other command, so
+     *        menu that doesn't need it doesn't pay for its screen buffers.
+     * @param watchCommand - watch command or nullptr, it may be given to one menu only.
+     */
+    void setWatch(WatchBase* watchCommand) noexcept;
 
  private:
     /**
-     * @brief Console port.
+     * @brief Console port, CLI replaces it with its output buffer.
      */
-    IODevice& port;
+    IODevice* port;
     /**
      * @brief List indicating current position in folder tree.
      */
-    std::vector<SubMenuBase*> activeMenu{};
+    std::array<const SubMenuBase*, MENUDEPTH> activeMenu;
+    /**
+     * @brief Number of used activeMenu entries, root folder is always there.
+     */
+    uint8_t depth;
+
+    /**
+     * @brief Recently resolved path that goes through sub-folders, repeated calls don't walk the tree.
+     */
+    struct CachedPath {
+        const SubMenuBase* from;  ///< sub-folder where path resolution started, nullptr for path starting at root
+        MenuItem* command;        ///< found command, nullptr for unused entry
+        uint8_t length;
+        char path[PATHCACHELENGTH];
+
+        [[nodiscard]] std::string_view text() const noexcept { return {path, length}; }
+    };
+    std::array<CachedPath, PATHCACHESIZE> pathCache;
+    /**
+     * @brief Cache entry that will be replaced by next resolved path.
+     */
+    uint8_t nextCachedPath;
+    /**
+     * @brief Prompt rendered for current position in folder tree, so redrawing it costs one write at any menu depth.
+     */
+    char prompt[PROMPTLENGTH];
+    /**
+     * @brief Length of rendered prompt, zero when it has to be rendered again.
+     */
+    uint8_t promptLength;
+    /**
+     * @brief Runs asynchronous commands, may be nullptr.
+     */
+    CommandExecutor* executor = nullptr;
+    /**
+     * @brief Asynchronous command call prepared by processCommand.
+     */
+    CommandJob job;
+    /**
+     * @brief Coroutine command started by processCommand.
+     */
+    CommandTask task;
+    /**
+     * @brief Cancellation request for running command.
+     */
+    CancellationToken cancellation;
+    /**
+     * @brief Built-in watch command, may be nullptr.
+     */
+    WatchBase* watch = nullptr;
+    /**
+     * @brief Running command is watch, any key stops it.
+     */
+    bool watching = false;
+
+    /**
+     * @return true when asynchronous or coroutine command handed to console didn't end yet.
+     */
+    [[nodiscard]] bool commandRunning() const noexcept { return job.busy() || static_cast<bool>(task); }
+
+    /**
+     * @brief Changes count of used activeMenu entries and invalidates rendered prompt.
+     * @param newDepth - new count of used activeMenu entries.
+     */
+    void setDepth(uint8_t newDepth) noexcept {
+        depth = newDepth;
+        promptLength = 0;
+    }
+    /**
+     * @brief Renders prompt for current position in folder tree.
+     * @return false when prompt doesn't fit into buffer.
+     */
+    bool renderPrompt() noexcept;
 
     /**
      * @brief Explores the tree of catalogs. Go into sub-folders, executes commands. Puts
      *        text on screen as a result of its work.
-     * @param words - list of words to process (order matters of course).
+     * @param commandLine - path to command followed by command parameters.
+     * @param mode - processing mode.
+     */
+    Result processPath(std::string_view commandLine, Mode mode);
+    /**
+     * @brief Processes command line watched by watch command in Batch mode, active sub-folder isn't changed.
+     * @param commandLine - command followed by its parameters.
+     * @param output - port that receives command output.
+     */
+    Result processWatched(std::string_view commandLine, IODevice& output);
+    /**
+     * @brief Executes command found in the tree.
+     * @param command - command handler.
+     * @param parameters - command parameters.
+     * @param mode - processing mode.
+     */
+    Result execute(MenuItem& command, std::string_view parameters, Mode mode);
+    /**
+     * @brief Starts prepared asynchronous command, runs it synchronously when executor can't start it.
+     * @param jobPort - port used by command.
+     */
+    void startJob(IODevice& jobPort) noexcept;
+    /**
+     * @brief Reports that command wasn't found.
+     * @param mode - processing mode.
      */
-    void processCommand(std::string_view command, std::string_view parameters);
+    Result notFound(Mode mode);
+    /**
+     * @brief Looks for cached path that command line starts with.
+     * @return Cache entry or nullptr when path wasn't cached.
+     */
+    const CachedPath* findCachedPath(std::string_view commandLine) const noexcept;
+    /**
+     * @brief Remembers resolved path, replaces the oldest cache entry. Paths longer than PATHCACHELENGTH aren't cached.
+     * @param from - sub-folder where path resolution started, nullptr for path starting at root.
+     * @param path - path text.
+     * @param command - found command.
+     */
+    void cachePath(const SubMenuBase* from, std::string_view path, MenuItem& command) noexcept;
 
     /**
      * @brief Goes count steps back to root folder. Safe.
@@ -89,28 +282,27 @@ class MainMenuBase {
     void drawPrompt();
 
     /**
-     * @brief Function for showing sub-folder content. Additionally word completion is done.
-     * @param words - list of given words.
-     * @param maxAppend - count of letters that could be added (without null termination).
-     * @return  Returns:
-     *          - string_view with letters to appended (if there was just one command conforming given name)
-     *          - empty string_view if there is no given sub-folder or there was more conforming items
+     * @brief Shows active sub-folder content in declaration order.
      */
-    std::string_view showCommands(std::string_view command);
-
- public:
+    void showCommands();
     /**
-     * @brief Creates a menu.
-     * @param port - IODevice console port.
+     * @brief Completes command name in active sub-folder.
+     * @param prefix - beginning of command name.
+     * @return Found commands count and their longest common prefix.
+     */
+    SubMenuBase::Completion complete(std::string_view prefix) const noexcept { return activeMenu[depth - 1]->complete(prefix); }
+    /**
+     * @brief Shows commands of active sub-folder which names start with given prefix.
+     * @param prefix - beginning of command name.
      */
-    MainMenuBase(IODevice& port, SubMenuBase& base) : port(port), activeMenu({&base}) {}
+    void showCandidates(std::string_view prefix);
 };
 
 template <size_t size>
 class MainMenu : public MainMenuBase {
  public:
     template <typename... Args>
-    MainMenu(IODevice& port, Args&... args) : MainMenuBase(port, submenu), submenu({}, args...) {}
+    constexpr MainMenu(IODevice& port, Args&... args) noexcept : MainMenuBase(port, submenu), submenu({}, args...) {}
 
     SubMenu<size> submenu;
 };
@@ -50,6 +50,9 @@
 
 namespace microhal {
 
+class AsyncMenuItem;
+class CoroutineMenuItem;
+
 /**
  * @brief MenuItem class, the base of all menu elements. Friend of all inheriting items classes.
  */
@@ -62,19 +65,11 @@ class MenuItem {
     explicit constexpr MenuItem(std::string_view name) noexcept : name(name) {}
     virtual ~MenuItem() = default;
 
-    /**
-     * @brief Wrapper for executing commands. Checks whether the invocation contains default
-     *        command help before the function will be called.
-     * @param command
-     * @param port
-     */
-    bool command(std::string_view command, std::string_view parameters, IODevice& port);
-
     /**
      * @brief Executes command.
      * @param parameters - test string with command arguments.
      * @param port - a console stream.
-     * @return Execution return value (for further implementation).
+     * @return Execution return value, non zero value (ex. cli::Status cast to int) marks failed command.
      */
     virtual int execute([[maybe_unused]] std::string_view parameters, [[maybe_unused]] IODevice& port) { return 0; }
 
@@ -85,6 +80,15 @@ class MenuItem {
      */
     virtual inline bool hasChildrens(void) { return false; }
 
+    /**
+     * @return Pointer to itself when item is AsyncMenuItem, nullptr otherwise.
+     */
+    virtual AsyncMenuItem *asAsync() noexcept { return nullptr; }
+    /**
+     * @return Pointer to itself when item is CoroutineMenuItem, nullptr otherwise.
+     */
+    virtual CoroutineMenuItem *asCoroutine() noexcept { return nullptr; }
+
     /**
      * @brief CLI object name.
      */
@@ -0,0 +1,104 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Output staging buffer placed between CLI and console IODevice.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_OUTPUTBUFFER_H_
+#define _CLI_OUTPUTBUFFER_H_
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include "IODevice/IODevice.h"
+
+namespace microhal {
+
+/**
+ * @brief IODevice adapter that collects everything written by CLI, MainMenuBase and commands and passes it to the console port
+ *        in as few write calls as possible. Data are sent when flush() is called or when the buffer fills up. Reads are forwarded
+ *        directly to the console port.
+ */
+class OutputBufferBase : public IODevice {
+ public:
+    using IODevice::write;
+
+    int open(OpenMode mode) noexcept final { return port.open(mode); }
+    void close() noexcept final {
+        flush();
+        port.close();
+    }
+    int isOpen() const noexcept final { return port.isOpen(); }
+
+    ssize_t read(char *buffer, size_t length) noexcept final { return port.read(buffer, length); }
+    ssize_t availableBytes() const noexcept final { return port.availableBytes(); }
+
+    /**
+     * @brief Appends data to the buffer. When data doesn't fit into free space buffer is flushed first, data bigger than whole
+     *        buffer are written directly to the console port.
+     * @return Number of bytes accepted.
+     */
+    ssize_t write(const char *data, size_t length) noexcept final;
+
+    /**
+     * @brief Sends buffered data to the console port with single write call (if port accepts all of them).
+     */
+    void flush() noexcept;
+
+    /**
+     * @return Number of bytes waiting for flush.
+     */
+    [[nodiscard]] size_t pending() const noexcept { return used; }
+    [[nodiscard]] size_t available() const noexcept { return buffer.size() - used; }
+    [[nodiscard]] size_t capacity() const noexcept { return buffer.size(); }
+
+    /**
+     * @brief Underlying console port.
+     */
+    [[nodiscard]] IODevice &device() const noexcept { return port; }
+
+    OutputBufferBase(const OutputBufferBase &) = delete;
+    OutputBufferBase &operator=(const OutputBufferBase &) = delete;
+
+ protected:
+    OutputBufferBase(IODevice &port, std::span<char> buffer) noexcept : port(port), buffer(buffer) {}
+
+ private:
+    IODevice &port;
+    std::span<char> buffer;
+    size_t used = 0;
+};
+
+template <size_t size>
+class OutputBuffer : public OutputBufferBase {
+ public:
+    explicit OutputBuffer(IODevice &port) noexcept : OutputBufferBase(port, storage) {}
+
+ private:
+    std::array<char, size> storage;
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_OUTPUTBUFFER_H_ */
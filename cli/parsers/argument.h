@@ -28,12 +28,14 @@
 #ifndef SRC_CLI_PARSERS_PARAMETERPARSER_H_
 #define SRC_CLI_PARSERS_PARAMETERPARSER_H_
 
-#include <charconv>
 #include <cstdint>
+#include <limits>
 #include <numeric>
 #include <span>
 #include <string_view>
+#include <utility>
 #include "IODevice/IODevice.h"
+#include "integerConversion.h"
 #include "status.h"
 
 namespace microhal {
@@ -52,6 +54,24 @@ constexpr Flag operator&(Flag lhs, Flag rhs) {
 
 }  // namespace implementationDetail
 
+/**
+ * @brief Options of argument used as ArgumentParser template parameter.
+ */
+struct Parameter {
+    enum class Flag : uint8_t {
+        Optional = 0,
+        Required = 0b1  ///< ArgumentParser reports missing argument when it wasn't given
+    };
+};
+
+/**
+ * @brief Base of argument parsers. Argument registered in RuntimeArgumentParser keeps parsed value itself and is parsed through
+ *        virtual parse(str). Argument declared as static constexpr object may be ArgumentParser template parameter, then every
+ *        derived class provides value_type and static parse(str, parameter) returning value and status, ArgumentParser calls it
+ *        directly and keeps values.
+ *        Derived class declares its destructor as `constexpr ~Derived() override {}`. The body must be user provided, because
+ *        g++ 12 rejects a defaulted virtual constexpr destructor of a static constexpr object.
+ */
 class Argument {
  public:
     using string_view = std::string_view;
@@ -65,35 +85,48 @@ class Argument {
     [[nodiscard]] constexpr bool wasParsed() const noexcept { return (flag & Flag::Parsed) == Flag::Parsed; }
     [[nodiscard]] constexpr bool wasLastTimeParsed() const noexcept { return (flag & Flag::LastTimeParsed) == Flag::LastTimeParsed; }
 
-    [[nodiscard]] int_fast8_t correctCommand(string_view cmd);
-    [[nodiscard]] virtual string_view formatArgument(std::span<char> buffer);
-
-    [[nodiscard]] string_view formatHelpEntry(std::span<char> buffer);
-    [[nodiscard]] string_view helpText() const { return help; }
+    /**
+     * @return Count of parameters that follow recognized command, -1 when command belongs to other argument.
+     */
+    [[nodiscard]] int_fast8_t correctCommand(string_view cmd) const { return recognizes(removeSpaces(cmd)); }
+    /**
+     * @brief Same as correctCommand but for option token that has no surrounding spaces.
+     */
+    [[nodiscard]] int_fast8_t recognizes(string_view option) const;
+    [[nodiscard]] virtual string_view formatArgument(std::span<char> buffer) { return formatParameterUsage(buffer); }
+    /**
+     * @brief Formats argument usage, ex. "[-b baud]". Derived class may hide it, ArgumentParser calls it without virtual dispatch.
+     */
+    [[nodiscard]] string_view formatParameterUsage(std::span<char> buffer) const;
+
+    [[nodiscard]] string_view formatHelpEntry(std::span<char> buffer) const;
+    [[nodiscard]] constexpr string_view helpText() const { return help; }
+    /**
+     * @return Name of argument value, or long command of argument without value. ArgumentParser::get finds arguments by it.
+     */
+    [[nodiscard]] constexpr string_view valueName() const { return name.size() ? name : command; }
+    /**
+     * @return Short option character, not positive when argument has no short option.
+     */
+    [[nodiscard]] constexpr signed char shortOption() const noexcept { return shortCommand; }
+    /**
+     * @return Long option name without leading "--".
+     */
+    [[nodiscard]] constexpr string_view longOption() const noexcept { return command; }
+    [[nodiscard]] constexpr uint_fast8_t expectedParameters() const noexcept { return parametersCount; }
 
  protected:
     constexpr Argument(signed char shortCommand, string_view command, string_view name, string_view help)
         : shortCommand(shortCommand), command(command), name(name), help(help) {}
+    constexpr Argument(signed char shortCommand, string_view command, string_view name, Parameter::Flag parameterFlag, string_view help)
+        : shortCommand(shortCommand), flag(parameterFlag == Parameter::Flag::Required ? Flag::Required : Flag{}), command(command), name(name), help(help) {}
 
     void clearLastTimeParsedFlag() { flag = flag & static_cast<Flag>(~static_cast<uint32_t>(Flag::LastTimeParsed)); }
 
     template <typename Type>
-    [[nodiscard]] static auto fromStringView(string_view str, uint_fast8_t base = 10, Type min = std::numeric_limits<Type>::min(),
-                                             Type max = std::numeric_limits<Type>::max()) {
-        Type result;
-        auto [ptr, error] = std::from_chars(str.begin(), str.end(), result, base);
-        struct OUT {
-            Type value;
-            Status ec;
-        };
-        if (error == std::errc()) {
-            if (result > max) return OUT{{}, Status::MaxViolation};
-            if (result < min) return OUT{{}, Status::MinViolation};
-            return OUT{result, Status::Success};
-        }
-        if (error == std::errc::result_out_of_range) return OUT{{}, Status::MaxViolation | Status::MinViolation};
-        if (error == std::errc::invalid_argument) return OUT{{}, Status::IncorectArgument};
-        return OUT{{}, Status::Error};
+    [[nodiscard]] static std::pair<Type, Status> fromStringView(string_view str, uint_fast8_t base = 10, Type min = std::numeric_limits<Type>::min(),
+                                                                Type max = std::numeric_limits<Type>::max()) {
+        return implementationDetail::toInteger<Type>(str, base, min, max);
     }
 
     [[nodiscard]] constexpr static string_view removeSpaces(string_view str) {
@@ -105,6 +138,10 @@ class Argument {
     }
 
     const signed char shortCommand;
+    /**
+     * @brief Count of parameters that follow command, zero for argument that is only a switch.
+     */
+    uint8_t parametersCount = 1;
     Flag flag{};
     const string_view command;
     const string_view name;
@@ -33,52 +33,52 @@ using namespace std::literals;
 namespace microhal {
 namespace cli {
 
-Status ArgumentParser::parse(std::string_view argumentsString, IODevice &ioDevice) {
-    // remove leading and trailing spaces
-    argumentsString = removeSpaces(argumentsString);
+namespace implementationDetail {
+bool Tokenizer::next(Token &token) noexcept {
+    const size_t size = parameters.size();
+    size_t pos = position;
+    while (pos < size && parameters[pos] == ' ') pos++;
+    if (pos == size) {
+        position = pos;
+        return false;
+    }
 
-    if (argumentsString.size() == 0 && arguments.size() != 0) return Status::NoArguments;
-    // decode all parameters
-    do {
-        const auto pos = argumentsString.find('-');
-        if (pos != argumentsString.npos) {
-            const auto argument = argumentsString.substr(pos, argumentsString.find(' ', pos));
-            if (isHelpArgument(argument)) {
-                showUsage(ioDevice);
-                return Status::HelpRequested;
-            }
-            bool argumentConsumed = false;
-            for (auto &arg : arguments) {
-                if (auto parameterCount = arg->correctCommand(argument); parameterCount >= 0) {
-                    const auto parameter = getParameters(argumentsString.substr(pos + argument.size()), parameterCount);
-                    if (auto status = arg->parse(parameter); status != Status::Success) return status;
+    const size_t begin = pos;
+    if (parameters[pos] == '"') {
+        token.kind = Token::Kind::Quoted;
+        // quoted token ends with closing quote, unterminated one with the end of parameters
+        pos = parameters.find('"', pos + 1);
+        pos = pos != parameters.npos ? pos + 1 : size;
+    } else {
+        token.kind = parameters[pos] == '-' ? Token::Kind::Option : Token::Kind::Value;
+        while (pos < size && parameters[pos] != ' ') pos++;
+    }
+    token.text = parameters.substr(begin, pos - begin);
+    position = pos;
+    return true;
+}
 
-                    argumentsString.remove_prefix(std::distance(argumentsString.begin(), parameter.end()));
-                    argumentConsumed = true;
-                    break;
-                }
-            }
-            if (!argumentConsumed) {
-                ioDevice.write("\n\r\tUnrecognized parameter: "sv);
-                ioDevice.write(argument);
-                return Status::UnrecognizedParameter;
-            }
-        }
-    } while (argumentsString.size());
-    return Status::Success;
+std::string_view Tokenizer::take(size_t count) noexcept {
+    Token last;
+    if (count == 0 || !next(last)) return {};
+    const char *const begin = last.text.data();
+    Token token;
+    for (size_t i = 1; i < count && next(token); i++) last = token;
+    return {begin, static_cast<size_t>(last.text.data() + last.text.size() - begin)};
 }
 
-void ArgumentParser::showUsage(IODevice &ioDevice) {
-    constexpr const std::string_view usage = "usage: ";
-    constexpr const std::string_view endl = "\n\r";
+void reportUnrecognized(IODevice &ioDevice, std::string_view parameter) {
+    ioDevice.write("\n\r\tUnrecognized parameter: "sv);
+    ioDevice.write(parameter);
+}
+
+void writeUsage(IODevice &ioDevice, std::string_view usage) {
+    ioDevice.putChar(' ');
     ioDevice.write(usage);
-    ioDevice.write(name);
-    for (auto argument : arguments) {
-        ioDevice.putChar(' ');
-        char buffer[30];
-        auto result = argument->formatArgument(buffer);
-        ioDevice.write(result);
-    }
+}
+
+void writeDescription(IODevice &ioDevice, std::string_view description) {
+    constexpr const std::string_view endl = "\n\r";
     ioDevice.write(endl);
     ioDevice.write(endl);
     ioDevice.write(description);
@@ -86,53 +86,51 @@ void ArgumentParser::showUsage(IODevice &ioDevice) {
     ioDevice.write(endl);
     ioDevice.write(endl);
     ioDevice.write("optional arguments:\n\r -h, --help         show this help message and exit"sv);
+}
+
+void writeHelpEntry(IODevice &ioDevice, const Argument &argument) {
+    constexpr const std::string_view endl = "\n\r";
     static constexpr const auto spaces = "                    "sv;
-    for (auto argument : arguments) {
+    ioDevice.write(endl);
+    char buffer[40];
+    const auto result = argument.formatHelpEntry(buffer);
+    ioDevice.write(result);
+    if (result.size() > 20) {
         ioDevice.write(endl);
-        char buffer[40];
-        const auto result = argument->formatHelpEntry(buffer);
-        ioDevice.write(result);
-        if (result.size() > 20) {
-            ioDevice.write(endl);
-            ioDevice.write(spaces);
-        } else {
-            ioDevice.write(spaces.substr(0, spaces.size() - result.size()));
-        }
-        ioDevice.write(argument->helpText());
+        ioDevice.write(spaces);
+    } else {
+        ioDevice.write(spaces.substr(0, spaces.size() - result.size()));
     }
-    ioDevice.write(endl);
+    ioDevice.write(argument.helpText());
 }
+}  // namespace implementationDetail
 
-bool ArgumentParser::isHelpArgument(std::string_view argument) {
-    // remove leading and trailing spaces
-    argument = removeSpaces(argument);
-
-    return argument == "-h"sv || argument == "--help"sv;
+Status ArgumentParserBase::parse(std::string_view argumentsString, IODevice &ioDevice) {
+    const Status status = implementationDetail::parseArguments(argumentsString, arguments.size() != 0, ioDevice,
+                                                               [this](string_view option, implementationDetail::Tokenizer &tokenizer) {
+                                                                   for (auto &arg : arguments) {
+                                                                       if (auto parametersCount = arg->recognizes(option); parametersCount >= 0) {
+                                                                           return arg->parse(tokenizer.take(parametersCount));
+                                                                       }
+                                                                   }
+                                                                   return Status::UnrecognizedParameter;
+                                                               });
+    if (status == Status::HelpRequested) showUsage(ioDevice);
+    return status;
 }
 
-std::string_view ArgumentParser::getParameters(std::string_view arguments, int8_t argumentsCount) {
-    // remove leading and trailing spaces
-    arguments = removeSpaces(arguments);
-
-    size_t argumentsBegin = 0;
-    do {
-        const auto stringQuoteBeginPos = arguments.find('"');
-        const auto stringQuoteEndPos = stringQuoteBeginPos != arguments.npos ? arguments.find('"', stringQuoteBeginPos) : arguments.npos;
-        auto parameterSeparator = arguments.find(' ', argumentsBegin);
-        if (parameterSeparator == arguments.npos) parameterSeparator = arguments.size();
-        if (stringQuoteBeginPos != arguments.npos) {
-            if (parameterSeparator > stringQuoteBeginPos && parameterSeparator < stringQuoteEndPos) {
-                argumentsBegin = stringQuoteEndPos;
-            } else {
-                argumentsCount--;
-            }
-        } else {
-            argumentsCount--;
-            argumentsBegin = parameterSeparator;
-        }
-    } while (argumentsCount);
-
-    return {arguments.data(), argumentsBegin};
+void ArgumentParserBase::showUsage(IODevice &ioDevice) {
+    ioDevice.write("usage: "sv);
+    ioDevice.write(name);
+    for (auto argument : arguments) {
+        char buffer[30];
+        implementationDetail::writeUsage(ioDevice, argument->formatArgument(buffer));
+    }
+    implementationDetail::writeDescription(ioDevice, description);
+    for (auto argument : arguments) {
+        implementationDetail::writeHelpEntry(ioDevice, *argument);
+    }
+    ioDevice.write("\n\r"sv);
 }
 
 }  // namespace cli
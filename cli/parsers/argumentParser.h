@@ -28,40 +28,345 @@
 #ifndef SRC_CLI_PARSERS_ARGUMENTPARSER_H_
 #define SRC_CLI_PARSERS_ARGUMENTPARSER_H_
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <string_view>
-#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "argument.h"
 #include "status.h"
 
 namespace microhal {
 namespace cli {
 
-class ArgumentParser {
+#define ARGUMENTSCOUNT 8
+
+namespace implementationDetail {
+/**
+ * @brief Part of command parameters delimited by spaces. Quoted token keeps its quotes and may contain spaces and dashes.
+ */
+struct Token {
+    enum class Kind : uint8_t {
+        Option,  ///< starts with '-', ex. "-b" or "--baudrate", it may also be a value of preceding option, ex. negative number
+        Value,
+        Quoted
+    };
+    Kind kind;
+    std::string_view text;
+};
+
+/**
+ * @brief Splits command parameters into tokens in a single pass. Tokens are read one at a time, so parameters count isn't
+ *        limited by token storage.
+ */
+class Tokenizer {
  public:
-    using string_view = std::string_view;
+    constexpr explicit Tokenizer(std::string_view parameters) noexcept : parameters(parameters) {}
 
-    ArgumentParser(string_view name, string_view description) : name(name), description(description) {}
+    /**
+     * @brief Reads next token.
+     * @return false when there are no more tokens.
+     */
+    [[nodiscard]] bool next(Token &token) noexcept;
+    /**
+     * @brief Reads count next tokens.
+     * @return Text spanning read tokens, it is empty when count is 0 or there are no more tokens.
+     */
+    [[nodiscard]] std::string_view take(size_t count) noexcept;
+
+ private:
+    std::string_view parameters;
+    size_t position = 0;
+};
+
+[[nodiscard]] constexpr bool isHelpArgument(std::string_view argument) {
+    using namespace std::literals;
+    return argument == "-h"sv || argument == "--help"sv;
+}
+
+void reportUnrecognized(IODevice &ioDevice, std::string_view parameter);
+
+/**
+ * @brief Splits command parameters into tokens and dispatches every option token to parseOption.
+ * @param argumentsString - command parameters.
+ * @param expectsArguments - parser has arguments, so empty parameters are reported with Status::NoArguments.
+ * @param ioDevice - port where unrecognized argument is reported.
+ * @param parseOption - callable (option, tokenizer) -> Status, it takes from tokenizer tokens used as option parameters,
+ *                      returns Status::UnrecognizedParameter when none of arguments recognized option.
+ */
+template <typename ParseOption>
+[[nodiscard]] Status parseArguments(std::string_view argumentsString, bool expectsArguments, IODevice &ioDevice, ParseOption &&parseOption) {
+    Tokenizer tokenizer(argumentsString);
+    Token token;
+    if (!tokenizer.next(token)) return expectsArguments ? Status::NoArguments : Status::Success;
+    do {
+        if (token.kind == Token::Kind::Option && isHelpArgument(token.text)) return Status::HelpRequested;
+        // value that doesn't follow any option can't be consumed
+        const Status status = token.kind == Token::Kind::Option ? parseOption(token.text, tokenizer) : Status::UnrecognizedParameter;
+        if (status == Status::UnrecognizedParameter) reportUnrecognized(ioDevice, token.text);
+        if (status != Status::Success) return status;
+    } while (tokenizer.next(token));
+    return Status::Success;
+}
+
+void writeUsage(IODevice &ioDevice, std::string_view usage);
+void writeDescription(IODevice &ioDevice, std::string_view description);
+void writeHelpEntry(IODevice &ioDevice, const Argument &argument);
+}  // namespace implementationDetail
+
+/**
+ * @brief Parses command parameters with registered arguments. Arguments are kept in storage provided by derived class, so
+ *        parser never allocates memory.
+ */
+class ArgumentParserBase {
+ public:
+    using string_view = std::string_view;
 
-    void addArgument(Argument &arg) { arguments.push_back(&arg); }
+    ArgumentParserBase(const ArgumentParserBase &) = delete;
+    ArgumentParserBase &operator=(const ArgumentParserBase &) = delete;
 
     [[nodiscard]] Status parse(std::string_view argumentsString, IODevice &ioDevice);
 
     void showUsage(IODevice &ioDevice);
 
- private:
-    bool isHelpArgument(std::string_view);
-    std::string_view getParameters(std::string_view arguments, int8_t argumentsCount);
+ protected:
+    ArgumentParserBase(string_view name, string_view description, std::span<Argument *> storage)
+        : storage(storage), name(name), description(description) {}
 
-    std::vector<Argument *> arguments{};
+    /**
+     * @brief Registers argument.
+     * @param arg - argument, has to live as long as parser.
+     * @return false when there is no space for argument.
+     */
+    bool addArgument(Argument &arg) {
+        if (arguments.size() == storage.size()) return false;
+        storage[arguments.size()] = &arg;
+        arguments = storage.first(arguments.size() + 1);
+        return true;
+    }
+
+ private:
+    std::span<Argument *> storage;
+    std::span<Argument *> arguments{};
     std::string_view name;
     std::string_view description;
+};
+
+/**
+ * @brief Argument parser which arguments are registered at runtime, it can hold up to capacity arguments.
+ */
+template <size_t capacity = ARGUMENTSCOUNT>
+class RuntimeArgumentParser : public ArgumentParserBase {
+ public:
+    RuntimeArgumentParser(string_view name, string_view description) : ArgumentParserBase(name, description, argumentsContainer) {}
+
+    using ArgumentParserBase::addArgument;
+
+ private:
+    std::array<Argument *, capacity> argumentsContainer{};
+};
+
+/**
+ * @brief Name of argument value given as ArgumentParser::get template argument: parser.get<{"baud"}>().
+ */
+template <size_t length>
+struct ParameterName {
+    constexpr ParameterName(const char (&text)[length]) noexcept { std::copy_n(text, length, name); }
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {name, length - 1}; }
+
+    char name[length];
+};
+
+/**
+ * @brief Argument parser which arguments are static constexpr objects given as template parameters. Argument names are resolved
+ *        to indexes at compile time, values are kept in the parser and every argument is parsed by direct call of its static
+ *        parse function, without virtual dispatch. Option tokens are resolved with lookup tables built at compile time, so
+ *        parse time doesn't grow with arguments count.
+ *        @code
+ *        static constexpr NumericParser<uint32_t> baud('b', "baudrate", "baud", Parameter::Flag::Required, "Baudrate", 10, 200000);
+ *        ArgumentParser<baud> parser("USART", "USART configuration.");
+ *        if (parser.parse(parameters, port) == Status::Success) setBaudrate(parser.get<{"baud"}>());
+ *        @endcode
+ */
+template <const auto &...parameters>
+class ArgumentParser {
+    static_assert(sizeof...(parameters) <= 32, "Parsed arguments are marked in 32 bit mask.");
+
+ public:
+    using string_view = std::string_view;
+
+    constexpr ArgumentParser(string_view name, string_view description) noexcept : name(name), description(description) {
+        static_assert(hasUniqueOptions(), "Two arguments have the same option.");
+    }
+
+    /**
+     * @brief Parses command parameters, values of previous call are cleared.
+     * @return Status::MissingArgument when required argument wasn't given, status of failed argument or Status::Success.
+     */
+    [[nodiscard]] Status parse(std::string_view argumentsString, IODevice &ioDevice) {
+        using namespace std::literals;
+        values = {};
+        parsed = 0;
+        const Status status = implementationDetail::parseArguments(argumentsString, sizeof...(parameters) != 0, ioDevice,
+                                                                   [this](string_view option, implementationDetail::Tokenizer &tokenizer) {
+                                                                       return parseOption(option, tokenizer);
+                                                                   });
+        if (status == Status::HelpRequested) showUsage(ioDevice);
+        if (status != Status::Success) return status;
+        return checkRequired(ioDevice, indexes{});
+    }
+
+    void showUsage(IODevice &ioDevice) const {
+        using namespace std::literals;
+        ioDevice.write("usage: "sv);
+        ioDevice.write(name);
+        (writeParameterUsage(ioDevice, parameters), ...);
+        implementationDetail::writeDescription(ioDevice, description);
+        (implementationDetail::writeHelpEntry(ioDevice, parameters), ...);
+        ioDevice.write("\n\r"sv);
+    }
+
+    /**
+     * @return Value of argument with given value name, default value when argument wasn't given.
+     */
+    template <ParameterName parameterName>
+    [[nodiscard]] constexpr auto get() const noexcept {
+        constexpr size_t index = indexOf(parameterName.view());
+        static_assert(index < sizeof...(parameters), "There is no argument with such value name.");
+        return std::get<index>(values);
+    }
+
+    /**
+     * @return true when argument with given value name was given.
+     */
+    template <ParameterName parameterName>
+    [[nodiscard]] constexpr bool isParsed() const noexcept {
+        constexpr size_t index = indexOf(parameterName.view());
+        static_assert(index < sizeof...(parameters), "There is no argument with such value name.");
+        return parsed & (1u << index);
+    }
+
+ private:
+    using indexes = std::index_sequence_for<decltype(parameters)...>;
+
+    std::tuple<typename std::remove_cvref_t<decltype(parameters)>::value_type...> values{};
+    uint32_t parsed = 0;
+    string_view name;
+    string_view description;
+
+    /**
+     * @return Index of argument with given value name, arguments count when there is no such argument.
+     */
+    [[nodiscard]] static consteval size_t indexOf(string_view parameterName) {
+        constexpr std::array<string_view, sizeof...(parameters)> names{parameters.valueName()...};
+        return std::distance(names.begin(), std::find(names.begin(), names.end(), parameterName));
+    }
+
+    /**
+     * @brief Lookup tables of options, built at compile time. Short option is found by direct lookup, long one by binary search
+     *        in names sorted at compile time.
+     */
+    struct OptionTables {
+        std::array<uint8_t, 128> shortOptions{};  ///< index + 1 of argument with given short option, 0 when there is no such argument
+        std::array<std::pair<string_view, uint8_t>, sizeof...(parameters)> longOptions{};  ///< long option and argument index
+        size_t longOptionsCount = 0;
+    };
+
+    static consteval OptionTables makeOptionTables() {
+        OptionTables tables;
+        uint8_t index = 0;
+        for (const Argument *argument : {static_cast<const Argument *>(&parameters)...}) {
+            if (argument->shortOption() > 0) tables.shortOptions[argument->shortOption()] = index + 1;
+            if (argument->longOption().size()) tables.longOptions[tables.longOptionsCount++] = {argument->longOption(), index};
+            index++;
+        }
+        std::sort(tables.longOptions.begin(), tables.longOptions.begin() + tables.longOptionsCount);
+        return tables;
+    }
+
+    static consteval bool hasUniqueOptions() {
+        std::array<size_t, 128> shortOptions{};
+        for (const Argument *argument : {static_cast<const Argument *>(&parameters)...}) {
+            if (argument->shortOption() > 0 && shortOptions[argument->shortOption()]++) return false;
+        }
+        const auto tables = makeOptionTables();
+        const auto last = tables.longOptions.begin() + tables.longOptionsCount;
+        return std::adjacent_find(tables.longOptions.begin(), last, [](const auto &a, const auto &b) { return a.first == b.first; }) == last;
+    }
+
+    /**
+     * @return Index of argument that recognizes option, arguments count when there is no such argument.
+     */
+    [[nodiscard]] static size_t findOption(string_view option) {
+        static constexpr OptionTables tables = makeOptionTables();
+        if (option.size() == 2 && option[0] == '-' && static_cast<unsigned char>(option[1]) < tables.shortOptions.size()) {
+            const auto index = tables.shortOptions[static_cast<unsigned char>(option[1])];
+            return index ? index - 1 : sizeof...(parameters);
+        }
+        if (option.starts_with("--")) {
+            option.remove_prefix(2);
+            const auto last = tables.longOptions.begin() + tables.longOptionsCount;
+            const auto it = std::lower_bound(tables.longOptions.begin(), last, option, [](const auto &entry, string_view name) { return entry.first < name; });
+            if (it != last && it->first == option) return it->second;
+        }
+        return sizeof...(parameters);
+    }
+
+    template <size_t index>
+    [[nodiscard]] static constexpr const auto &parameterAt() noexcept {
+        return std::get<index>(std::tie(parameters...));
+    }
+
+    using OptionParser = Status (ArgumentParser::*)(implementationDetail::Tokenizer &tokenizer);
+
+    template <size_t... index>
+    static consteval std::array<OptionParser, sizeof...(index)> makeOptionParsers(std::index_sequence<index...>) {
+        return {&ArgumentParser::parseAt<index>...};
+    }
+
+    [[nodiscard]] Status parseOption(string_view option, implementationDetail::Tokenizer &tokenizer) {
+        static constexpr std::array<OptionParser, sizeof...(parameters)> optionParsers = makeOptionParsers(indexes{});
+        const size_t index = findOption(option);
+        if (index == sizeof...(parameters)) return Status::UnrecognizedParameter;
+        return (this->*optionParsers[index])(tokenizer);
+    }
+
+    template <size_t index>
+    [[nodiscard]] Status parseAt(implementationDetail::Tokenizer &tokenizer) {
+        constexpr const auto &argument = parameterAt<index>();
+        using ArgumentType = std::remove_cvref_t<decltype(argument)>;
+        const auto [value, status] = ArgumentType::parse(tokenizer.take(argument.expectedParameters()), argument);
+        if (status == Status::Success) {
+            std::get<index>(values) = value;
+            parsed |= 1u << index;
+        }
+        return status;
+    }
+
+    template <size_t... index>
+    [[nodiscard]] Status checkRequired(IODevice &ioDevice, std::index_sequence<index...>) const {
+        // the first missing argument is reported
+        const bool missing = ((parameters.isRequired() && !(parsed & (1u << index)) && reportMissing(ioDevice, parameters)) || ...);
+        return missing ? Status::MissingArgument : Status::Success;
+    }
+
+    template <typename ArgumentType>
+    static bool reportMissing(IODevice &ioDevice, const ArgumentType &argument) {
+        using namespace std::literals;
+        char buffer[40];
+        ioDevice.write("\n\r\tMissing argument: "sv);
+        ioDevice.write(argument.formatParameterUsage(buffer));
+        return true;
+    }
 
-    [[nodiscard]] constexpr static string_view removeSpaces(string_view str) {
-        // remove leading spaces
-        if (auto pos = str.find_first_not_of(' '); pos != str.npos) str.remove_prefix(pos);
-        // remove trailing spaces
-        if (auto pos = str.find_last_not_of(' '); pos != str.npos) str.remove_suffix(str.size() - pos - 1);
-        return str;
+    template <typename ArgumentType>
+    static void writeParameterUsage(IODevice &ioDevice, const ArgumentType &argument) {
+        char buffer[30];
+        implementationDetail::writeUsage(ioDevice, argument.formatParameterUsage(buffer));
     }
 };
 
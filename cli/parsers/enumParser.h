@@ -28,7 +28,10 @@
 #ifndef SRC_CLI_PARSERS_ENUMPARSER_H_
 #define SRC_CLI_PARSERS_ENUMPARSER_H_
 
+#include <algorithm>
 #include <optional>
+#include <system_error>
+#include <utility>
 #include "argument.h"
 
 namespace microhal {
@@ -38,24 +41,38 @@ template <typename Map>
 class EnumParser : public Argument {
  public:
     using key_t = typename Map::key_t;
+    using value_type = key_t;
 
     constexpr EnumParser(Map &map, char shortCommand, string_view command, string_view help)
         : Argument(shortCommand, command, "{...}", help), map(map) {}
+    constexpr EnumParser(Map &map, signed char shortCommand, string_view command, Parameter::Flag flag, string_view help)
+        : Argument(shortCommand, command, "{...}", flag, help), map(map) {}
 
-    constexpr ~EnumParser() = default;
+    constexpr ~EnumParser() override {}
 
     [[nodiscard]] constexpr Status parse(string_view str) final {
-        str = removeSpaces(str);
-        auto result = map.keyFor(str);
-        if (result.ec == std::errc()) {
-            m_key = result.key;
+        const auto [value, status] = parse(str, *this);
+        if (status == Status::Success) {
+            m_key = value;
             flag = flag | Flag::LastTimeParsed | Flag::Parsed;
-            return Status::Success;
         }
-        return Status::Error;
+        return status;
     }
 
-    [[nodiscard]] string_view formatArgument(std::span<char> buffer) final {
+    [[nodiscard]] constexpr static std::pair<key_t, Status> parse(string_view str, const EnumParser &parameter) {
+        auto result = parameter.map.keyFor(removeSpaces(str));
+        if (result.ec == std::errc()) return {result.key, Status::Success};
+        return {key_t{}, Status::Error};
+    }
+
+    /**
+     * @brief Enum argument is found by its long command, its value name is "{...}".
+     */
+    [[nodiscard]] constexpr string_view valueName() const { return command; }
+
+    [[nodiscard]] string_view formatArgument(std::span<char> buffer) final { return formatParameterUsage(buffer); }
+
+    [[nodiscard]] string_view formatParameterUsage(std::span<char> buffer) const {
         buffer[0] = '[';
         buffer[1] = '-';
         char *ptr = &buffer[3];
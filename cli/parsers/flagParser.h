@@ -29,6 +29,7 @@
 #define SRC_CLI_PARSERS_FLAGPARSER_H_
 
 #include <optional>
+#include <utility>
 #include "argument.h"
 
 namespace microhal {
@@ -36,17 +37,29 @@ namespace cli {
 
 class FlagParser : public Argument {
  public:
-    constexpr FlagParser(signed char shortCommand, string_view command, string_view help) : Argument(shortCommand, command, {}, help) {}
-    constexpr ~FlagParser() = default;
+    using value_type = bool;
+
+    constexpr FlagParser(signed char shortCommand, string_view command, string_view help) : Argument(shortCommand, command, {}, help) {
+        parametersCount = 0;
+    }
+    constexpr FlagParser(signed char shortCommand, string_view command, Parameter::Flag flag, string_view help)
+        : Argument(shortCommand, command, {}, flag, help) {
+        parametersCount = 0;
+    }
+    constexpr ~FlagParser() override {}
 
     [[nodiscard]] constexpr Status parse(string_view str) final {
-        str = removeSpaces(str);
-        if (str.size() == 0) {
-            flagStatus = true;
+        const auto [value, status] = parse(str, *this);
+        if (status == Status::Success) {
+            flagStatus = value;
             flag = flag | Flag::LastTimeParsed | Flag::Parsed;
-            return Status::Success;
         }
-        return Status::Error;
+        return status;
+    }
+
+    [[nodiscard]] constexpr static std::pair<bool, Status> parse(string_view str, [[maybe_unused]] const FlagParser &parameter) {
+        if (removeSpaces(str).size() == 0) return {true, Status::Success};
+        return {false, Status::Error};
     }
 
     [[nodiscard]] constexpr std::optional<bool> value() const noexcept {
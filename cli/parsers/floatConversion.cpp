@@ -0,0 +1,180 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Locale independent floating point conversion
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "floatConversion.h"
+#include <array>
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+
+namespace microhal {
+namespace cli {
+namespace implementationDetail {
+
+namespace {
+/**
+ * @brief Number in form: mantissa * 10^exponent.
+ */
+struct Decimal {
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    uint_fast8_t significantDigits = 0;
+    bool negative = false;
+    bool truncated = false;  ///< some of non zero digits didn't fit in mantissa
+};
+
+// 19 decimal digits always fit in 64 bit mantissa
+constexpr uint_fast8_t maxSignificantDigits = 19;
+// bigger exponents give infinity or zero anyway
+constexpr int32_t maxExponent = 100000;
+
+[[nodiscard]] constexpr bool equalsIgnoreCase(std::string_view str, std::string_view lowercase) {
+    if (str.size() != lowercase.size()) return false;
+    for (size_t i = 0; i < str.size(); i++) {
+        if ((str[i] | 0x20) != lowercase[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @return false when text isn't decimal number.
+ */
+[[nodiscard]] bool scanDecimal(std::string_view str, Decimal &decimal) {
+    const auto isDigit = [&str](size_t pos) { return pos < str.size() && static_cast<unsigned char>(str[pos] - '0') < 10; };
+    const auto addDigit = [&decimal](char digit) {
+        if (decimal.mantissa == 0 && digit == '0') return false;
+        if (decimal.significantDigits < maxSignificantDigits) {
+            decimal.mantissa = decimal.mantissa * 10 + (digit - '0');
+            decimal.significantDigits++;
+            return true;
+        }
+        decimal.truncated |= digit != '0';
+        return false;
+    };
+
+    size_t pos = 0;
+    bool digits = false;
+    for (; isDigit(pos); pos++) {
+        digits = true;
+        // integer digit that didn't fit in mantissa multiplies it by 10
+        if (!addDigit(str[pos]) && decimal.mantissa) decimal.exponent++;
+    }
+    if (pos < str.size() && str[pos] == '.') {
+        for (pos++; isDigit(pos); pos++) {
+            digits = true;
+            // fraction digit added to mantissa divides it by 10, leading zeros too
+            if (addDigit(str[pos]) || decimal.mantissa == 0) decimal.exponent--;
+        }
+    }
+    if (!digits) return false;
+
+    if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+        pos++;
+        bool negativeExponent = false;
+        if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) negativeExponent = str[pos++] == '-';
+        if (!isDigit(pos)) return false;
+        int32_t exponent = 0;
+        for (; isDigit(pos); pos++) {
+            if (exponent < maxExponent) exponent = exponent * 10 + (str[pos] - '0');
+        }
+        decimal.exponent += negativeExponent ? -exponent : exponent;
+    }
+    if (decimal.mantissa == 0) decimal.exponent = 0;
+    return pos == str.size();
+}
+
+template <typename Type>
+struct FastPath;
+
+template <>
+struct FastPath<double> {
+    // integers up to 2^53 and powers of 10 up to 10^22 are exact in double
+    static constexpr uint64_t maxMantissa = uint64_t{1} << 53;
+    static constexpr std::array<double, 23> powers{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template <>
+struct FastPath<float> {
+    // integers up to 2^24 and powers of 10 up to 10^10 are exact in float
+    static constexpr uint64_t maxMantissa = uint64_t{1} << 24;
+    static constexpr std::array<float, 11> powers{1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+template <typename Type>
+[[nodiscard]] std::pair<Type, Status> convert(std::string_view str, Type min, Type max) {
+    Decimal decimal;
+    // from_chars doesn't accept plus sign
+    if (str.starts_with('+')) {
+        str.remove_prefix(1);
+    } else if (str.starts_with('-')) {
+        decimal.negative = true;
+    }
+    const auto number = decimal.negative ? str.substr(1) : str;
+
+    Type value;
+    if (equalsIgnoreCase(number, "inf") || equalsIgnoreCase(number, "infinity")) {
+        value = std::numeric_limits<Type>::infinity();
+        if (decimal.negative) value = -value;
+    } else if (!scanDecimal(number, decimal)) {
+        return {{}, Status::IncorectArgument};
+    } else if (constexpr auto &powers = FastPath<Type>::powers; FLT_EVAL_METHOD == 0 && !decimal.truncated &&
+               decimal.mantissa <= FastPath<Type>::maxMantissa && decimal.exponent < static_cast<int32_t>(powers.size()) &&
+               decimal.exponent > -static_cast<int32_t>(powers.size())) {
+        // both operands are exact, so single operation gives correctly rounded result
+        value = static_cast<Type>(decimal.mantissa);
+        value = decimal.exponent < 0 ? value / powers[-decimal.exponent] : value * powers[decimal.exponent];
+        if (decimal.negative) value = -value;
+    } else {
+        const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if (error == std::errc::result_out_of_range) {
+            // number is too big when its first significant digit is before decimal point, otherwise it is too small
+            value = decimal.significantDigits + decimal.exponent > 0 ? std::numeric_limits<Type>::infinity() : Type{0};
+            if (decimal.negative) value = -value;
+        } else if (error != std::errc() || end != str.data() + str.size()) {
+            return {{}, Status::IncorectArgument};
+        }
+    }
+
+    if (value > max) return {{}, Status::MaxViolation};
+    if (value < min) return {{}, Status::MinViolation};
+    return {value, Status::Success};
+}
+}  // namespace
+
+std::pair<float, Status> toFloatingPoint(std::string_view str, float min, float max) {
+    return convert<float>(str, min, max);
+}
+
+std::pair<double, Status> toFloatingPoint(std::string_view str, double min, double max) {
+    return convert<double>(str, min, max);
+}
+
+}  // namespace implementationDetail
+}  // namespace cli
+}  // namespace microhal
@@ -0,0 +1,53 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Locale independent floating point conversion
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_CLI_PARSERS_FLOATCONVERSION_H_
+#define SRC_CLI_PARSERS_FLOATCONVERSION_H_
+
+#include <string_view>
+#include <utility>
+#include "status.h"
+
+namespace microhal {
+namespace cli {
+namespace implementationDetail {
+
+/**
+ * @brief Converts decimal number, ex. "-12.5e3", "inf" or "infinity", to floating point value. Conversion works directly on text,
+ *        doesn't depend on locale and result is correctly rounded. Short numbers are converted exactly with single multiplication
+ *        or division, longer ones by std::from_chars.
+ * @return Value and Status::Success, Status::IncorectArgument when text isn't a number, Status::MaxViolation or Status::MinViolation
+ *         when value is outside [min, max] range.
+ */
+[[nodiscard]] std::pair<float, Status> toFloatingPoint(std::string_view str, float min, float max);
+[[nodiscard]] std::pair<double, Status> toFloatingPoint(std::string_view str, double min, double max);
+
+}  // namespace implementationDetail
+}  // namespace cli
+}  // namespace microhal
+
+#endif /* SRC_CLI_PARSERS_FLOATCONVERSION_H_ */
@@ -0,0 +1,206 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Integer conversion with range check fused into digit loop
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_CLI_PARSERS_INTEGERCONVERSION_H_
+#define SRC_CLI_PARSERS_INTEGERCONVERSION_H_
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "status.h"
+
+namespace microhal {
+namespace cli {
+namespace implementationDetail {
+
+/**
+ * @brief Value of digit in any base up to 36, 0xFF for characters that are not digits.
+ */
+inline constexpr std::array<uint8_t, 256> digitValues = [] {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (uint8_t i = 0; i < 10; i++) values['0' + i] = i;
+    for (uint8_t i = 0; i < 26; i++) values['a' + i] = values['A' + i] = 10 + i;
+    return values;
+}();
+
+/**
+ * @brief Converts eight decimal digits at once, all of them are checked and converted with a few 64 bit operations.
+ * @return false when any of characters isn't decimal digit.
+ */
+[[nodiscard]] inline bool eightDigits(const char *digits, uint64_t &value) {
+    if constexpr (std::endian::native != std::endian::little) {
+        uint64_t result = 0;
+        for (uint_fast8_t i = 0; i < 8; i++) {
+            if (digitValues[static_cast<unsigned char>(digits[i])] >= 10) return false;
+            result = result * 10 + digitValues[static_cast<unsigned char>(digits[i])];
+        }
+        value = result;
+        return true;
+    } else {
+        uint64_t chunk;
+        std::memcpy(&chunk, digits, sizeof(chunk));
+        // high nibble of every byte has to be 3 and low one can't exceed 9, so adding 6 can't change high nibble
+        if (((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333) return false;
+        // first digit is in lowest byte, pairs of bytes, then pairs of 16 bit and 32 bit halves are merged
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * (256 * 10 + 1)) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FF) * (65536 * 100 + 1)) >> 16;
+        value = ((chunk & 0x0000FFFF0000FFFF) * (4294967296 * 10000 + 1)) >> 32;
+        return true;
+    }
+}
+
+/**
+ * @brief Appends digits to magnitude without overflow check, it is inlined with constant base for common bases.
+ * @return false when any of characters isn't digit.
+ */
+template <typename Magnitude>
+[[nodiscard]] inline bool accumulateDigits(std::string_view digits, uint_fast8_t base, Magnitude &magnitude) {
+    for (const char character : digits) {
+        const uint_fast8_t digit = base <= 10 ? static_cast<uint_fast8_t>(character - '0') : digitValues[static_cast<unsigned char>(character)];
+        if (digit >= base) return false;
+        magnitude = magnitude * base + digit;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends digits to magnitude, stops when magnitude would overflow.
+ * @return Status::Success, Status::IncorectArgument when character isn't digit, violation on overflow.
+ */
+template <typename Magnitude>
+[[nodiscard]] inline Status accumulateCheckedDigits(std::string_view digits, uint_fast8_t base, Magnitude &magnitude, Status violation) {
+    const Magnitude lastMagnitude = std::numeric_limits<Magnitude>::max() / base;
+    for (const char character : digits) {
+        const uint_fast8_t digit = digitValues[static_cast<unsigned char>(character)];
+        if (digit >= base) return Status::IncorectArgument;
+        if (magnitude > lastMagnitude) return violation;
+        magnitude = magnitude * base + digit;
+        // after overflow of the addition magnitude is smaller than added digit
+        if (magnitude < digit) return violation;
+    }
+    return Status::Success;
+}
+
+/**
+ * @return Count of digits in given base that can't overflow Magnitude.
+ */
+template <typename Magnitude>
+[[nodiscard]] constexpr size_t safeDigits(uint_fast8_t base) {
+    if (base == 10) return std::numeric_limits<Magnitude>::digits10;
+    if (base == 16) return std::numeric_limits<Magnitude>::digits / 4;
+    size_t digits = 0;
+    for (Magnitude magnitude = std::numeric_limits<Magnitude>::max(); magnitude >= base; magnitude /= base) digits++;
+    return digits;
+}
+
+/**
+ * @brief Converts text to integer, text can't contain anything but optional minus sign, prefix and digits. Digits that can't
+ *        overflow are converted without any check, eight decimal digits at once, so range is checked once per number.
+ * @param base - base from 2 to 36 or 0, then base is detected from "0x" or "0b" prefix and decimal is used when there is no prefix.
+ * @return Value and Status::Success, Status::IncorectArgument when text isn't a number, Status::MaxViolation or Status::MinViolation
+ *         when value is outside [min, max] range.
+ */
+template <typename Type>
+[[nodiscard]] std::pair<Type, Status> toInteger(std::string_view str, uint_fast8_t base, Type min, Type max) {
+    static_assert(std::is_integral_v<Type> && sizeof(Type) <= sizeof(uint64_t));
+    // 32 bit arithmetic is enough for smaller types, eight digits chunk fits in it too
+    using Magnitude = std::conditional_t<sizeof(Type) <= sizeof(uint32_t), uint32_t, uint64_t>;
+
+    bool negative = false;
+    if (str.starts_with('-')) {
+        if constexpr (std::is_unsigned_v<Type>) return {{}, Status::IncorectArgument};
+        negative = true;
+        str.remove_prefix(1);
+    }
+    if (base == 0) {
+        base = 10;
+        if (str.size() > 2 && str[0] == '0') {
+            if (str[1] == 'x' || str[1] == 'X') base = 16;
+            if (str[1] == 'b' || str[1] == 'B') base = 2;
+            if (base != 10) str.remove_prefix(2);
+        }
+    }
+    if (str.empty() || base < 2 || base > 36) return {{}, Status::IncorectArgument};
+    // leading zeros don't change value, without them digits count tells if magnitude may overflow
+    while (str.size() > 1 && str[0] == '0') str.remove_prefix(1);
+
+    const Status violation = negative ? Status::MinViolation : Status::MaxViolation;
+    Magnitude magnitude = 0;
+    bool digits;
+    if (base == 10) {
+        auto safe = str.substr(0, safeDigits<Magnitude>(10));
+        str.remove_prefix(safe.size());
+        // eight digits chunks are used only by types that may have so many digits
+        if constexpr (std::numeric_limits<Type>::digits10 >= 8) {
+            for (; safe.size() >= 8; safe.remove_prefix(8)) {
+                uint64_t chunk;
+                if (!eightDigits(safe.data(), chunk)) return {{}, Status::IncorectArgument};
+                magnitude = magnitude * 100'000'000 + static_cast<Magnitude>(chunk);
+            }
+        }
+        digits = accumulateDigits<Magnitude>(safe, 10, magnitude);
+    } else if (base == 16) {
+        const auto safe = str.substr(0, safeDigits<Magnitude>(16));
+        str.remove_prefix(safe.size());
+        digits = accumulateDigits<Magnitude>(safe, 16, magnitude);
+    } else {
+        const auto safe = str.substr(0, safeDigits<Magnitude>(base));
+        str.remove_prefix(safe.size());
+        digits = accumulateDigits<Magnitude>(safe, base, magnitude);
+    }
+    if (!digits) return {{}, Status::IncorectArgument};
+    // digits that may overflow magnitude are left only in the longest numbers
+    if (str.size()) {
+        if (const auto status = accumulateCheckedDigits<Magnitude>(str, base, magnitude, violation); status != Status::Success) return {{}, status};
+    }
+
+    // magnitude of value can't exceed limit, otherwise value is outside range
+    Magnitude limit = 0;
+    if constexpr (std::is_signed_v<Type>) {
+        if (negative && min < 0) limit = Magnitude{0} - static_cast<Magnitude>(min);
+    }
+    if (!negative && max > 0) limit = static_cast<Magnitude>(max);
+    if (magnitude > limit) return {{}, violation};
+
+    // magnitude fits in Type here, only the opposite bound is left to check
+    const Type value = static_cast<Type>(negative ? ~magnitude + 1 : magnitude);
+    if (value > max) return {{}, Status::MaxViolation};
+    if (value < min) return {{}, Status::MinViolation};
+    return {value, Status::Success};
+}
+
+}  // namespace implementationDetail
+}  // namespace cli
+}  // namespace microhal
+
+#endif /* SRC_CLI_PARSERS_INTEGERCONVERSION_H_ */
@@ -31,6 +31,15 @@ namespace microhal {
 namespace cli {
 
 Status IPMaskParser::parse(string_view str) {
+    const auto [value, status] = parse(str, *this);
+    if (status == Status::Success) {
+        m_ip = value;
+        flag = flag | Flag::LastTimeParsed | Flag::Parsed;
+    }
+    return status;
+}
+
+std::pair<IP, Status> IPMaskParser::parse(string_view str, [[maybe_unused]] const IPMaskParser &parameter) {
     // Parse string: 255.255.255.0
 
     str = removeSpaces(str);
@@ -38,20 +47,15 @@ Status IPMaskParser::parse(string_view str) {
     for (uint_fast8_t i = 0; i < 4; i++) {
         auto dotPos = str.find('.');
         auto number = str.substr(0, dotPos);
-        if (number.find(' ') != number.npos) return Status::Error;
+        if (number.find(' ') != number.npos) return {{}, Status::Error};
         auto [value, error] = fromStringView<uint8_t>(number);
-        if (error != Status::Success) return Status::Error;
+        if (error != Status::Success) return {{}, Status::Error};
         tmpIp.ip[3 - i] = value;
         str.remove_prefix(dotPos + 1);
     }
 
-    if (validateMask(tmpIp)) {
-        m_ip = tmpIp;
-        flag = flag | Flag::LastTimeParsed | Flag::Parsed;
-        return Status::Success;
-    }
-
-    return Status::Error;
+    if (validateMask(tmpIp)) return {tmpIp, Status::Success};
+    return {{}, Status::Error};
 }
 
 bool IPMaskParser::validateMask(IP mask) {
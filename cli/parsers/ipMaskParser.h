@@ -29,6 +29,7 @@
 #define SRC_CLI_PARSERS_IPMASKPARSER_H_
 
 #include <optional>
+#include <utility>
 #include "argument.h"
 #include "commonTypes/ip.h"
 #include "status.h"
@@ -38,9 +39,14 @@ namespace cli {
 
 class IPMaskParser : public Argument {
  public:
+    using value_type = IP;
+
     constexpr IPMaskParser(string_view command, string_view name, string_view help) : Argument(-1, command, name, help) {}
+    constexpr IPMaskParser(string_view command, string_view name, Parameter::Flag flag, string_view help) : Argument(-1, command, name, flag, help) {}
+    constexpr ~IPMaskParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final;
+    [[nodiscard]] static std::pair<IP, Status> parse(string_view str, const IPMaskParser &parameter);
 
     [[nodiscard]] std::optional<IP> mask() const {
         if (wasParsed()) return m_ip;
@@ -31,23 +31,30 @@ namespace microhal {
 namespace cli {
 
 Status IPParser::parse(string_view str) {
+    const auto [value, status] = parse(str, *this);
+    if (status == Status::Success) {
+        m_ip = value;
+        flag = flag | Flag::LastTimeParsed | Flag::Parsed;
+    }
+    return status;
+}
+
+std::pair<IP, Status> IPParser::parse(string_view str, [[maybe_unused]] const IPParser &parameter) {
     // Parse string: 192.168.11.1
 
     str = removeSpaces(str);
-    if (str.size() == 0) return Status::MissingArgument;
+    if (str.size() == 0) return {{}, Status::MissingArgument};
     IP tmpIp;
     for (uint_fast8_t i = 0; i < 4; i++) {
         auto dotPos = str.find('.');
         auto number = str.substr(0, dotPos);
-        if (number.find(' ') != number.npos) return Status::IncorectArgument;
+        if (number.find(' ') != number.npos) return {{}, Status::IncorectArgument};
         auto [value, error] = fromStringView<uint8_t>(number);
-        if (error != Status::Success) return Status::IncorectArgument;
+        if (error != Status::Success) return {{}, Status::IncorectArgument};
         tmpIp.ip[3 - i] = value;
         str.remove_prefix(dotPos + 1);
     }
-    m_ip = tmpIp;
-    flag = flag | Flag::LastTimeParsed | Flag::Parsed;
-    return Status::Success;
+    return {tmpIp, Status::Success};
 }
 
 }  // namespace cli
@@ -29,6 +29,7 @@
 #define SRC_CLI_IPPARSER_H_
 
 #include <optional>
+#include <utility>
 #include "argument.h"
 #include "commonTypes/ip.h"
 
@@ -37,9 +38,14 @@ namespace cli {
 
 class IPParser : public Argument {
  public:
+    using value_type = IP;
+
     constexpr IPParser(string_view command, string_view name, string_view help) : Argument(-1, command, name, help) {}
+    constexpr IPParser(string_view command, string_view name, Parameter::Flag flag, string_view help) : Argument(-1, command, name, flag, help) {}
+    constexpr ~IPParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final;
+    [[nodiscard]] static std::pair<IP, Status> parse(string_view str, const IPParser &parameter);
 
     [[nodiscard]] std::optional<const IP> ip() const {
         if (wasParsed()) return m_ip;
@@ -31,6 +31,7 @@
 #include <cmath>
 #include <cstdint>
 #include <string_view>
+#include <utility>
 #include "argument.h"
 
 namespace microhal {
@@ -39,19 +40,33 @@ namespace cli {
 template <typename Type>
 class NumericParser : public Argument {
  public:
+    using value_type = Type;
+    /**
+     * @brief Base of number detected from its prefix: "0x" hexadecimal, "0b" binary, decimal when there is no prefix.
+     */
+    static constexpr uint_fast8_t prefixedBase = 0;
+
     constexpr NumericParser(char shotCommand, string_view command, string_view name, string_view help, Type min, Type max, uint_fast8_t base = 10)
         : Argument(shotCommand, command, name, help), base(base), min(min), max(max) {}
+    constexpr NumericParser(signed char shotCommand, string_view command, string_view name, Parameter::Flag flag, string_view help, Type min, Type max,
+                            uint_fast8_t base = 10)
+        : Argument(shotCommand, command, name, flag, help), base(base), min(min), max(max) {}
+    constexpr ~NumericParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final {
+        const auto [value, status] = parse(str, *this);
+        if (status == Status::Success) parsedValue = value;
+        return status;
+    }
+
+    [[nodiscard]] static std::pair<Type, Status> parse(string_view str, const NumericParser &parameter) {
         str = removeSpaces(str);
-        if (str.size() == 0) return Status::MissingArgument;
+        if (str.size() == 0) return {{}, Status::MissingArgument};
         // spaces in the middle of data are not allowed, return error
-        if (str.find(' ') != str.npos) return Status::IncorectArgument;
+        if (str.find(' ') != str.npos) return {{}, Status::IncorectArgument};
 
-        auto [value, error] = fromStringView<Type>(str, base, min, max);
-        if (error != Status::Success) return error;
-        parsedValue = value;
-        return Status::Success;
+        const auto [value, error] = fromStringView<Type>(str, parameter.base, parameter.min, parameter.max);
+        return {value, error};
     }
 
     [[nodiscard]] Type value() const { return parsedValue; }
@@ -66,10 +81,16 @@ class NumericParser : public Argument {
 template <>
 class NumericParser<float> : public Argument {
  public:
+    using value_type = float;
+
     constexpr NumericParser(char shotCommand, string_view command, string_view name, string_view help, float min, float max)
         : Argument(shotCommand, command, name, help), min(min), max(max) {}
+    constexpr NumericParser(signed char shotCommand, string_view command, string_view name, Parameter::Flag flag, string_view help, float min, float max)
+        : Argument(shotCommand, command, name, flag, help), min(min), max(max) {}
+    constexpr ~NumericParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final;
+    [[nodiscard]] static std::pair<float, Status> parse(string_view str, const NumericParser &parameter);
     [[nodiscard]] float value() const { return parsedValue; }
 
  private:
@@ -81,10 +102,16 @@ class NumericParser<float> : public Argument {
 template <>
 class NumericParser<double> : public Argument {
  public:
+    using value_type = double;
+
     constexpr NumericParser(char shotCommand, string_view command, string_view name, string_view help, double min, double max)
         : Argument(shotCommand, command, name, help), min(min), max(max) {}
+    constexpr NumericParser(signed char shotCommand, string_view command, string_view name, Parameter::Flag flag, string_view help, double min, double max)
+        : Argument(shotCommand, command, name, flag, help), min(min), max(max) {}
+    constexpr ~NumericParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final;
+    [[nodiscard]] static std::pair<double, Status> parse(string_view str, const NumericParser &parameter);
     [[nodiscard]] double value() const { return parsedValue; }
 
  private:
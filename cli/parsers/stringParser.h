@@ -29,6 +29,7 @@
 #define SRC_CLI_PARSERS_STRINGPARSER_H_
 
 #include <optional>
+#include <utility>
 #include "argument.h"
 
 namespace microhal {
@@ -36,10 +37,17 @@ namespace cli {
 
 class StringParser : public Argument {
  public:
+    using value_type = string_view;
+
     constexpr StringParser(signed char shortCommand, string_view command, string_view name, string_view help, uint16_t minLength, uint16_t maxLength)
         : Argument(shortCommand, command, name, help), maxLength(maxLength), minLength(minLength) {}
+    constexpr StringParser(signed char shortCommand, string_view command, string_view name, Parameter::Flag flag, string_view help, uint16_t minLength,
+                           uint16_t maxLength)
+        : Argument(shortCommand, command, name, flag, help), maxLength(maxLength), minLength(minLength) {}
+    constexpr ~StringParser() override {}
 
     [[nodiscard]] Status parse(string_view str) final;
+    [[nodiscard]] static std::pair<string_view, Status> parse(string_view str, const StringParser &parameter);
 
     [[nodiscard]] constexpr string_view value() const noexcept { return string; }
 
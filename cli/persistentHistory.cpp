@@ -0,0 +1,81 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Command history kept in memory-mapped file, Linux only.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if defined(__linux__)
+
+#include "persistentHistory.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace microhal {
+
+PersistentHistory::PersistentHistory(const char *fileName, size_t arenaSize) noexcept
+    : arenaSize(std::min<size_t>(arenaSize, UINT16_MAX)) {
+    fd = open(fileName, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) return;
+
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) != 0) return;
+    const bool sizeMatches = static_cast<size_t>(fileStatus.st_size) == fileSize();
+    // file of unexpected size is recreated, all its content is dropped
+    if (!sizeMatches && (ftruncate(fd, 0) != 0 || ftruncate(fd, fileSize()) != 0)) return;
+
+    void *memory = mmap(nullptr, fileSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) return;
+    header = static_cast<Header *>(memory);
+
+    if (!sizeMatches || !std::equal(std::begin(magic), std::end(magic), header->magic) || header->arenaSize != this->arenaSize) {
+        std::copy(std::begin(magic), std::end(magic), header->magic);
+        header->arenaSize = this->arenaSize;
+        header->state = {};
+    }
+    // entries are validated by History, corrupted history is cleared there
+}
+
+PersistentHistory::~PersistentHistory() {
+    if (header) {
+        sync();
+        munmap(header, fileSize());
+    }
+    if (fd >= 0) close(fd);
+}
+
+std::span<char> PersistentHistory::arena() noexcept {
+    if (!header) return {};
+    return {reinterpret_cast<char *>(header + 1), arenaSize};
+}
+
+void PersistentHistory::sync() noexcept {
+    if (header) msync(header, fileSize(), MS_SYNC);
+}
+
+}  // namespace microhal
+
+#endif  // defined(__linux__)
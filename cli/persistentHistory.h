@@ -0,0 +1,92 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Command history kept in memory-mapped file, Linux only.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_PERSISTENTHISTORY_H_
+#define _CLI_PERSISTENTHISTORY_H_
+
+#if defined(__linux__)
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "history.h"
+
+namespace microhal {
+
+/**
+ * @brief Fixed-size file mapped into memory and used directly as CLI history arena. History survives restarts without being
+ *        parsed or replayed at startup, and storing a command costs only memory writes. File is synchronized with msync when
+ *        PersistentHistory is destroyed. File that is truncated, has different arena size or holds corrupted entries starts
+ *        as empty history.
+ */
+class PersistentHistory {
+ public:
+    /**
+     * @param fileName - history file, created when it doesn't exist.
+     * @param arenaSize - size of history arena, at most 64kB.
+     */
+    PersistentHistory(const char *fileName, size_t arenaSize) noexcept;
+    ~PersistentHistory();
+
+    PersistentHistory(const PersistentHistory &) = delete;
+    PersistentHistory &operator=(const PersistentHistory &) = delete;
+
+    /**
+     * @return true if file is mapped, otherwise arena is empty and no history is kept.
+     */
+    [[nodiscard]] bool isOpen() const noexcept { return header != nullptr; }
+    /**
+     * @brief Arena and history state placed in the file, to be passed to CLI<std::dynamic_extent>.
+     */
+    [[nodiscard]] std::span<char> arena() noexcept;
+    [[nodiscard]] History::State &state() noexcept { return header ? header->state : unmappedState; }
+    /**
+     * @brief Writes history to the file.
+     */
+    void sync() noexcept;
+
+ private:
+    struct Header {
+        char magic[8];
+        uint32_t arenaSize;
+        History::State state;
+    };
+    static constexpr char magic[8] = {'u', 'C', 'L', 'I', 'H', 'I', 'S', '1'};
+
+    Header *header = nullptr;
+    size_t arenaSize;
+    int fd = -1;
+    History::State unmappedState{};
+
+    [[nodiscard]] size_t fileSize() const noexcept { return sizeof(Header) + arenaSize; }
+};
+
+}  // namespace microhal
+
+#endif  // defined(__linux__)
+
+#endif /* _CLI_PERSISTENTHISTORY_H_ */
@@ -0,0 +1,254 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Scheduler running CLI commands periodically or after delay.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "scheduler.h"
+#include <algorithm>
+#include <charconv>
+#include "duration.h"
+#include "mainMenu.h"
+
+using namespace std::literals;
+
+namespace microhal {
+
+namespace {
+void writeNumber(IODevice &port, uint64_t value) {
+    char text[20];
+    const auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+    port.write(text, end - text);
+}
+}  // namespace
+
+SchedulerBase::SchedulerBase(MainMenuBase &menu, IODevice &port, std::span<Entry> entries) noexcept
+    : menu(menu), port(port), entries(entries) {
+    slots.fill(none);
+}
+
+uint32_t SchedulerBase::schedule(std::string_view commandLine, Tick delay, Tick period) noexcept {
+    if (commandLine.size() > SCHEDULERLINELENGTH) return 0;
+    const auto found = menu.findCommand(commandLine);
+    if (found.command == nullptr) return 0;
+
+    uint16_t index = freeEntries;
+    if (index != none) {
+        freeEntries = entries[index].next;
+    } else if (touched < entries.size()) {
+        index = touched++;
+    } else {
+        return 0;
+    }
+    Entry &entry = entries[index];
+    entry.command = found.command;
+    // slot of current tick was already processed
+    entry.expires = current + std::max<Tick::rep>(delay.count(), 1);
+    entry.period = period.count();
+    entry.lineLength = commandLine.copy(entry.line, sizeof(entry.line));
+    entry.parametersPosition = found.parameters.data() - commandLine.data();
+    insert(index);
+    ++used;
+    return id(index);
+}
+
+bool SchedulerBase::cancel(uint32_t id) noexcept {
+    if (id == 0) return false;
+    const uint16_t index = (id - 1) % entries.size();
+    if (index >= touched || entries[index].command == nullptr || this->id(index) != id) return false;
+    if (index == running) {
+        // entry isn't in the wheel while its command runs
+        cancelled = true;
+        return true;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+void SchedulerBase::poll(Clock::time_point now) {
+    if (!started) {
+        start = now;
+        started = true;
+    }
+    const auto target = static_cast<uint32_t>(std::chrono::duration_cast<Tick>(now - start).count());
+    while (current != target) {
+        // nothing to run, empty ticks are skipped
+        if (used == 0) {
+            current = target;
+            break;
+        }
+        ++current;
+        cascade();
+        fire();
+    }
+}
+
+void SchedulerBase::insert(uint16_t index) noexcept {
+    Entry &entry = entries[index];
+    const uint32_t delta = entry.expires - current;
+    uint32_t when = entry.expires;
+    uint_fast8_t level = 0;
+    while (level + 1 < SCHEDULERLEVELS && delta >> ((level + 1) * SCHEDULERWHEELBITS)) {
+        ++level;
+    }
+    // beyond wheel range, entry waits in the farthest slot and is placed again when it cascades
+    if constexpr (SCHEDULERLEVELS * SCHEDULERWHEELBITS < 32) {
+        if (delta >> (SCHEDULERLEVELS * SCHEDULERWHEELBITS)) when = current + (1u << (SCHEDULERLEVELS * SCHEDULERWHEELBITS)) - 1;
+    }
+    const uint16_t slot = level * slotsCount + ((when >> (level * SCHEDULERWHEELBITS)) & slotMask);
+    entry.slot = slot;
+    entry.previous = none;
+    entry.next = slots[slot];
+    if (entry.next != none) entries[entry.next].previous = index;
+    slots[slot] = index;
+}
+
+void SchedulerBase::unlink(uint16_t index) noexcept {
+    const Entry &entry = entries[index];
+    if (entry.previous == none) {
+        slots[entry.slot] = entry.next;
+    } else {
+        entries[entry.previous].next = entry.next;
+    }
+    if (entry.next != none) entries[entry.next].previous = entry.previous;
+}
+
+void SchedulerBase::release(uint16_t index) noexcept {
+    Entry &entry = entries[index];
+    entry.command = nullptr;
+    ++entry.generation;
+    entry.next = freeEntries;
+    freeEntries = index;
+    --used;
+}
+
+void SchedulerBase::cascade() noexcept {
+    for (uint_fast8_t level = 1; level < SCHEDULERLEVELS; ++level) {
+        // lower level didn't wrap around
+        if ((current >> ((level - 1) * SCHEDULERWHEELBITS)) & slotMask) break;
+        const uint16_t slot = level * slotsCount + ((current >> (level * SCHEDULERWHEELBITS)) & slotMask);
+        uint16_t index = slots[slot];
+        slots[slot] = none;
+        while (index != none) {
+            const uint16_t next = entries[index].next;
+            insert(index);
+            index = next;
+        }
+    }
+}
+
+void SchedulerBase::fire() {
+    const uint16_t slot = current & slotMask;
+    // command may schedule or cancel entries, so slot is read again after every run
+    while (slots[slot] != none) {
+        const uint16_t index = slots[slot];
+        unlink(index);
+        Entry &entry = entries[index];
+        running = index;
+        entry.command->execute(entry.parameters(), port);
+        running = none;
+        if (entry.period && !cancelled) {
+            entry.expires += entry.period;
+            insert(index);
+        } else {
+            release(index);
+        }
+        cancelled = false;
+    }
+}
+
+int SchedulerBase::Command::execute(std::string_view parameters, IODevice &port) {
+    switch (kind) {
+        case Kind::Every:
+            return scheduler.scheduleCommand(parameters, port, true);
+        case Kind::At:
+            return scheduler.scheduleCommand(parameters, port, false);
+        case Kind::List:
+            scheduler.showEntries(port);
+            return 0;
+        case Kind::Cancel:
+            return scheduler.cancelCommandEntry(parameters, port);
+    }
+    return -1;
+}
+
+int SchedulerBase::scheduleCommand(std::string_view parameters, IODevice &port, bool periodic) {
+    auto timeText = parameters.substr(0, parameters.find(' '));
+    const auto commandLine = parameters.substr(std::min(timeText.size() + 1, parameters.size()));
+    // there is no wall clock, only time relative to now is known
+    const bool relative = periodic || timeText.starts_with('+');
+    if (!periodic) timeText.remove_prefix(relative);
+    const Tick time = relative ? parseDuration(timeText) : Tick::zero();
+    if (time <= time.zero() || commandLine.empty()) {
+        port.write(periodic ? "\tusage: every <interval> <command>"sv : "\tusage: at +<delay> <command>"sv);
+        return -1;
+    }
+    const uint32_t entry = schedule(commandLine, time, periodic ? time : Tick::zero());
+    if (entry == 0) {
+        if (commandLine.size() > SCHEDULERLINELENGTH) {
+            port.write("\tcommand line too long..."sv);
+        } else if (menu.findCommand(commandLine).command == nullptr) {
+            port.write("\tno such command..."sv);
+        } else {
+            port.write("\tscheduler is full..."sv);
+        }
+        return -1;
+    }
+    port.write("\tid "sv);
+    writeNumber(port, entry);
+    return 0;
+}
+
+int SchedulerBase::cancelCommandEntry(std::string_view parameters, IODevice &port) {
+    uint32_t entry = 0;
+    const auto [end, error] = std::from_chars(parameters.data(), parameters.data() + parameters.size(), entry);
+    if (error != std::errc() || end != parameters.data() + parameters.size() || !cancel(entry)) {
+        port.write("\tno such entry..."sv);
+        return -1;
+    }
+    return 0;
+}
+
+void SchedulerBase::showEntries(IODevice &port) const {
+    for (uint16_t index = 0; index < touched; ++index) {
+        const Entry &entry = entries[index];
+        if (entry.command == nullptr) continue;
+        port.write("\n\r\t"sv);
+        writeNumber(port, id(index));
+        if (entry.period) {
+            port.write("\tevery "sv);
+            writeNumber(port, entry.period);
+            port.write("ms"sv);
+        } else {
+            port.write("\tonce"sv);
+        }
+        port.write("\tnext in "sv);
+        writeNumber(port, index == running ? entry.period : entry.expires - current);
+        port.write("ms\t"sv);
+        port.write(entry.text());
+    }
+}
+
+}  // namespace microhal
@@ -0,0 +1,211 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Scheduler running CLI commands periodically or after delay.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_SCHEDULER_H_
+#define _CLI_SCHEDULER_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "IODevice/IODevice.h"
+#include "menuItem.h"
+
+namespace microhal {
+
+#define SCHEDULERENTRIES 16
+#define SCHEDULERLINELENGTH 32
+#define SCHEDULERWHEELBITS 6
+#define SCHEDULERLEVELS 4
+
+class MainMenuBase;
+
+/**
+ * @brief Runs menu commands periodically or once after delay: `every 500ms sensor read`, `at +10s reboot`. Entries are kept in
+ *        hierarchical timer wheel of SCHEDULERLEVELS levels, each of 2^SCHEDULERWHEELBITS slots, with 1ms tick. Adding,
+ *        cancelling and every tick are O(1), entry is moved to lower level at most SCHEDULERLEVELS - 1 times before it fires.
+ *        Scheduler is driven by poll(), called from the same loop as CLI::readInput, due commands are executed synchronously
+ *        inside poll(). Management commands `every`, `at`, `list` and `cancel` are ready to be added to menu. Scheduler only
+ *        keeps reference to the menu, so it may be constructed before the menu that holds its commands:
+ *        @code
+ *        Scheduler<> scheduler(mainMenu, port);
+ *        SubMenu<4> schedule("schedule", scheduler.everyCommand, scheduler.atCommand, scheduler.listCommand, scheduler.cancelCommand);
+ *        MainMenu<2> mainMenu(port, sensor, schedule);
+ *        @endcode
+ */
+class SchedulerBase {
+ public:
+    using Clock = std::chrono::steady_clock;
+    using Tick = std::chrono::milliseconds;
+
+    /**
+     * @brief Management command executed by CLI.
+     */
+    class Command final : public MenuItem {
+     public:
+        enum class Kind : uint8_t { Every, At, List, Cancel };
+
+        constexpr Command(std::string_view name, SchedulerBase &scheduler, Kind kind) noexcept
+            : MenuItem(name), scheduler(scheduler), kind(kind) {}
+
+        int execute(std::string_view parameters, IODevice &port) final;
+
+     private:
+        SchedulerBase &scheduler;
+        Kind kind;
+    };
+
+    /**
+     * @brief Scheduled command.
+     */
+    struct Entry {
+        MenuItem *command = nullptr;  ///< nullptr for free entry
+        uint32_t expires = 0;         ///< tick when command runs
+        uint32_t period = 0;          ///< ticks between runs, zero for command that runs once
+        uint16_t next = none;         ///< next entry in wheel slot or in free list
+        uint16_t previous = none;     ///< previous entry in wheel slot, none for the first one
+        uint16_t slot = 0;            ///< wheel slot holding entry
+        uint16_t generation = 0;      ///< incremented when entry is reused, so old id doesn't cancel new entry
+        uint8_t lineLength = 0;
+        uint8_t parametersPosition = 0;
+        char line[SCHEDULERLINELENGTH];
+
+        [[nodiscard]] std::string_view text() const noexcept { return {line, lineLength}; }
+        [[nodiscard]] std::string_view parameters() const noexcept { return text().substr(parametersPosition); }
+    };
+
+    /**
+     * @brief Schedules command. Command is found when scheduled, relative paths start at active sub-folder of the menu.
+     * @param commandLine - path to command followed by its parameters, at most SCHEDULERLINELENGTH chars.
+     * @param delay - time from last poll to the first run.
+     * @param period - time between runs, zero for command that runs once.
+     * @return Entry id, zero when command wasn't found, line is too long or there is no free entry.
+     */
+    uint32_t schedule(std::string_view commandLine, Tick delay, Tick period = {}) noexcept;
+    /**
+     * @brief Removes scheduled command, running command may cancel itself.
+     * @param id - entry id returned by schedule.
+     * @return false when there is no such entry.
+     */
+    bool cancel(uint32_t id) noexcept;
+
+    /**
+     * @brief Runs commands that are due. First call sets time when scheduler starts.
+     */
+    void poll() { poll(Clock::now()); }
+    /**
+     * @brief Runs commands that are due at given time, time goes forward only.
+     * @param now - current time.
+     */
+    void poll(Clock::time_point now);
+
+    /**
+     * @return Count of scheduled commands.
+     */
+    [[nodiscard]] size_t size() const noexcept { return used; }
+
+    Command everyCommand{"every", *this, Command::Kind::Every};
+    Command atCommand{"at", *this, Command::Kind::At};
+    Command listCommand{"list", *this, Command::Kind::List};
+    Command cancelCommand{"cancel", *this, Command::Kind::Cancel};
+
+    SchedulerBase(const SchedulerBase &) = delete;
+    SchedulerBase &operator=(const SchedulerBase &) = delete;
+
+ protected:
+    /**
+     * @param menu - menu where scheduled commands are looked for.
+     * @param port - port passed to scheduled commands.
+     * @param entries - storage for entries.
+     */
+    SchedulerBase(MainMenuBase &menu, IODevice &port, std::span<Entry> entries) noexcept;
+
+ private:
+    static constexpr uint16_t none = UINT16_MAX;
+    static constexpr uint32_t slotsCount = 1 << SCHEDULERWHEELBITS;
+    static constexpr uint32_t slotMask = slotsCount - 1;
+
+    MainMenuBase &menu;
+    IODevice &port;
+    std::span<Entry> entries;
+    std::array<uint16_t, slotsCount * SCHEDULERLEVELS> slots;
+    /**
+     * @brief Released entries, linked by Entry::next.
+     */
+    uint16_t freeEntries = none;
+    /**
+     * @brief Count of entries that were used at least once, the rest is taken in order. Entries aren't touched in
+     *        constructor, because they are constructed after base class.
+     */
+    uint16_t touched = 0;
+    uint16_t used = 0;
+    /**
+     * @brief Last processed tick.
+     */
+    uint32_t current = 0;
+    Clock::time_point start{};
+    bool started = false;
+    /**
+     * @brief Entry which command is executed, cancelling it only marks it with cancelled.
+     */
+    uint16_t running = none;
+    bool cancelled = false;
+
+    [[nodiscard]] uint32_t id(uint16_t index) const noexcept { return entries[index].generation * entries.size() + index + 1; }
+
+    void insert(uint16_t index) noexcept;
+    void unlink(uint16_t index) noexcept;
+    void release(uint16_t index) noexcept;
+    /**
+     * @brief Moves entries from higher level slots that became current to lower levels.
+     */
+    void cascade() noexcept;
+    /**
+     * @brief Runs commands from level 0 slot of current tick.
+     */
+    void fire();
+
+    int scheduleCommand(std::string_view parameters, IODevice &port, bool periodic);
+    int cancelCommandEntry(std::string_view parameters, IODevice &port);
+    void showEntries(IODevice &port) const;
+};
+
+template <size_t capacity = SCHEDULERENTRIES>
+class Scheduler : public SchedulerBase {
+    static_assert(capacity < UINT16_MAX, "Entries are linked with uint16_t indexes.");
+
+ public:
+    Scheduler(MainMenuBase &menu, IODevice &port) noexcept : SchedulerBase(menu, port, storage) {}
+
+ private:
+    std::array<Entry, capacity> storage;
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_SCHEDULER_H_ */
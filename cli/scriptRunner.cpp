@@ -0,0 +1,103 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Non-interactive execution of command scripts.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "scriptRunner.h"
+#include <algorithm>
+
+namespace microhal {
+
+ScriptRunner::Summary ScriptRunner::run(std::string_view script) {
+    Summary summary{};
+    previousCR = false;
+    skipping = false;
+    const size_t consumed = processLines(script, summary);
+    // last line doesn't need to be terminated
+    if (!summary.stopped && consumed < script.size()) processLine(script.substr(consumed), summary);
+    return summary;
+}
+
+ScriptRunner::Summary ScriptRunner::run(IODevice &input) {
+    Summary summary{};
+    previousCR = false;
+    skipping = false;
+    size_t used = 0;
+    while (!summary.stopped) {
+        const ssize_t received = input.read(&lineBuffer[used], sizeof(lineBuffer) - used);
+        if (received <= 0) break;
+        used += received;
+
+        const size_t consumed = processLines({lineBuffer, used}, summary);
+        std::copy(&lineBuffer[consumed], &lineBuffer[used], lineBuffer);
+        used -= consumed;
+        if (used == sizeof(lineBuffer) && !summary.stopped) {
+            summary.lines++;
+            reportResult({lineBuffer, used}, {MainMenuBase::Result::Status::LineTooLong, 0}, summary);
+            skipping = true;
+            used = 0;
+        }
+    }
+    if (!summary.stopped && used && !skipping) processLine({lineBuffer, used}, summary);
+    return summary;
+}
+
+size_t ScriptRunner::processLines(std::string_view text, Summary &summary) {
+    size_t consumed = 0;
+    while (!summary.stopped) {
+        if (previousCR && consumed < text.size()) {
+            previousCR = false;
+            if (text[consumed] == '\n') consumed++;
+        }
+        const size_t end = text.find_first_of("\r\n", consumed);
+        if (end == text.npos) break;
+        previousCR = text[end] == '\r';
+        if (skipping) {
+            // end of line that didn't fit into buffer, it was already reported
+            skipping = false;
+        } else {
+            processLine(text.substr(consumed, end - consumed), summary);
+        }
+        consumed = end + 1;
+    }
+    return consumed;
+}
+
+void ScriptRunner::processLine(std::string_view line, Summary &summary) {
+    summary.lines++;
+    if (line.empty() || line.front() == '#') return;
+    summary.executed++;
+    reportResult(line, menu.processCommand(line, MainMenuBase::Mode::Batch), summary);
+}
+
+void ScriptRunner::reportResult(std::string_view line, MainMenuBase::Result result, Summary &summary) {
+    if (result.failed()) {
+        summary.failed++;
+        if (onError == OnError::Stop) summary.stopped = true;
+    }
+    lineProcessed(summary.lines, line, result);
+}
+
+}  // namespace microhal
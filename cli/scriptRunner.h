@@ -0,0 +1,133 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Non-interactive execution of command scripts.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_SCRIPTRUNNER_H_
+#define _CLI_SCRIPTRUNNER_H_
+
+#include <cstddef>
+#include <string_view>
+#include "IODevice/IODevice.h"
+#include "mainMenu.h"
+
+namespace microhal {
+
+#define SCRIPTLINELENGTH 128
+
+/**
+ * @brief Feeds command lines from a script straight into MainMenuBase::processCommand in batch mode, so there is no echo,
+ *        no prompt and no new line before command output. Lines are separated by CR, LF or CR LF, empty lines and lines
+ *        starting with '#' are skipped. Menu position changed by script (ex. entering sub menu) is kept after the script ends.
+ *
+ *        Status of every processed line is passed to lineProcessed, override it to log or report results:
+ *        @code
+ *        class Provisioning : public ScriptRunner {
+ *            using ScriptRunner::ScriptRunner;
+ *            void lineProcessed(size_t lineNumber, std::string_view line, MainMenuBase::Result result) final { ... }
+ *        };
+ *        @endcode
+ */
+class ScriptRunner {
+ public:
+    enum class OnError : uint8_t {
+        Stop,     ///< stop on first failed line
+        Continue  ///< execute all lines
+    };
+
+    struct Summary {
+        /**
+         * @brief Number of lines read, including empty and comment lines. When script was stopped it's the failed line number.
+         */
+        size_t lines = 0;
+        /**
+         * @brief Number of lines passed to menu.
+         */
+        size_t executed = 0;
+        /**
+         * @brief Number of failed lines, including lines too long to be passed to menu.
+         */
+        size_t failed = 0;
+        /**
+         * @brief Set when script was stopped on failed line.
+         */
+        bool stopped = false;
+    };
+
+    /**
+     * @param menu - menu executing commands, command output goes to its port.
+     * @param onError - what to do when command fails.
+     */
+    explicit ScriptRunner(MainMenuBase &menu, OnError onError = OnError::Stop) noexcept : menu(menu), onError(onError) {}
+    virtual ~ScriptRunner() = default;
+
+    ScriptRunner(const ScriptRunner &) = delete;
+    ScriptRunner &operator=(const ScriptRunner &) = delete;
+
+    /**
+     * @brief Executes script held in memory (ex. embedded in firmware or memory-mapped file). Lines may be of any length.
+     */
+    Summary run(std::string_view script);
+    /**
+     * @brief Executes script read from stream until read returns no data. Lines longer than SCRIPTLINELENGTH aren't executed
+     *        and are reported as failed.
+     */
+    Summary run(IODevice &input);
+
+ protected:
+    /**
+     * @brief Called after every line passed to menu.
+     * @param lineNumber - line number, starting from 1.
+     * @param line - processed line.
+     * @param result - command result.
+     */
+    virtual void lineProcessed([[maybe_unused]] size_t lineNumber, [[maybe_unused]] std::string_view line,
+                               [[maybe_unused]] MainMenuBase::Result result) {}
+
+ private:
+    MainMenuBase &menu;
+    OnError onError;
+    /**
+     * @brief Set when last processed line ended with CR, so LF of CR LF pair is skipped.
+     */
+    bool previousCR = false;
+    /**
+     * @brief Set while the rest of too long line is skipped.
+     */
+    bool skipping = false;
+    char lineBuffer[SCRIPTLINELENGTH];
+
+    /**
+     * @brief Processes all complete lines of text.
+     * @return Number of consumed chars, the rest is beginning of line that isn't complete yet.
+     */
+    size_t processLines(std::string_view text, Summary &summary);
+    void processLine(std::string_view line, Summary &summary);
+    void reportResult(std::string_view line, MainMenuBase::Result result, Summary &summary);
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_SCRIPTRUNNER_H_ */
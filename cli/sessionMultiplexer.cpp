@@ -0,0 +1,60 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Serves many CLI sessions from a single event loop.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sessionMultiplexer.h"
+
+namespace microhal {
+
+bool SessionMultiplexerBase::add(CLIBase &session) {
+    if (count == sessions.size()) return false;
+    sessions[count++] = &session;
+    return true;
+}
+
+void SessionMultiplexerBase::remove(CLIBase &session) {
+    for (size_t i = 0; i < count; i++) {
+        if (sessions[i] == &session) {
+            sessions[i] = sessions[--count];
+            sessions[count] = nullptr;
+            return;
+        }
+    }
+}
+
+size_t SessionMultiplexerBase::readInput() {
+    size_t served = 0;
+    for (size_t i = 0; i < count; i++) {
+        // running command is resumed, or finished, by readInput even when no key was pressed
+        if (sessions[i]->inputAvailable() || sessions[i]->commandRunning()) {
+            sessions[i]->readInput();
+            ++served;
+        }
+    }
+    return served;
+}
+
+}  // namespace microhal
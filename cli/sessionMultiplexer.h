@@ -0,0 +1,101 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Serves many CLI sessions from a single event loop.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_SESSIONMULTIPLEXER_H_
+#define _CLI_SESSIONMULTIPLEXER_H_
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include "CLI.h"
+
+namespace microhal {
+
+/**
+ * @brief Keeps a set of independent CLI sessions and serves their input from one loop. Every session has its own CLI and
+ *        MainMenuBase (so its own line buffer, history and position in menu tree), while all of them may be built on top of
+ *        one shared menu tree:
+ *        @code
+ *        SubMenu<2> tree("", clock, memory);
+ *        MainMenuBase menu1(console1, tree), menu2(console2, tree);
+ *        CLI cli1(console1, menu1), cli2(console2, menu2);
+ *        SessionMultiplexer<2> sessions(cli1, cli2);
+ *        @endcode
+ */
+class SessionMultiplexerBase {
+ public:
+    /**
+     * @brief Adds session.
+     * @return false when there is no space for another session.
+     */
+    bool add(CLIBase &session);
+    /**
+     * @brief Removes session, order of remaining sessions may change.
+     */
+    void remove(CLIBase &session);
+
+    /**
+     * @brief Serves every session that has input waiting in its console or runs asynchronous or coroutine command, so
+     *        running commands advance without waiting for a key. While any session runs command it should be called
+     *        frequently, not only when some console has data.
+     * @return Number of sessions served.
+     */
+    size_t readInput();
+    /**
+     * @brief Serves single session. Intended for event loops that already know which console is ready (ex. from poll on Linux).
+     */
+    void readInput(size_t index) { sessions[index]->readInput(); }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] CLIBase &operator[](size_t index) { return *sessions[index]; }
+
+ protected:
+    explicit SessionMultiplexerBase(std::span<CLIBase *> sessions) : sessions(sessions) {}
+    SessionMultiplexerBase(std::span<CLIBase *> sessions, size_t count) : sessions(sessions), count(count) {}
+
+ private:
+    std::span<CLIBase *> sessions;
+    size_t count = 0;
+};
+
+template <size_t maxSessions>
+class SessionMultiplexer : public SessionMultiplexerBase {
+ public:
+    SessionMultiplexer() : SessionMultiplexerBase(sessionsContainer) {}
+
+    template <typename... Sessions>
+    SessionMultiplexer(Sessions &... sessions) : SessionMultiplexerBase(sessionsContainer, sizeof...(Sessions)), sessionsContainer({&sessions...}) {
+        static_assert(sizeof...(Sessions) <= maxSessions, "Too many sessions.");
+    }
+
+ private:
+    std::array<CLIBase *, maxSessions> sessionsContainer{};
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_SESSIONMULTIPLEXER_H_ */
@@ -43,11 +43,78 @@
  */
 
 #include "subMenu.h"
-
+#include <algorithm>
+#include <numeric>
 
 namespace microhal {
 
-} /* namespace hal */
+const MenuEntry* SubMenuBase::find(std::string_view name) const noexcept {
+    if (index.size() != items.size()) {
+        auto it = std::find_if(items.begin(), items.end(), [name](const MenuEntry& entry) { return entry.name() == name; });
+        return it != items.end() ? &*it : nullptr;
+    }
+    auto it = std::lower_bound(index.begin(), index.end(), name,
+                               [this](uint16_t position, std::string_view name) { return items[position].name() < name; });
+    if (it != index.end() && items[*it].name() == name) return &items[*it];
+    return nullptr;
+}
+
+SubMenuBase::Completion SubMenuBase::complete(std::string_view prefix) const noexcept {
+    const auto commonPrefix = [](std::string_view a, std::string_view b) {
+        const auto [end, _] = std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin());
+        return a.substr(0, std::distance(a.begin(), end));
+    };
+
+    if (index.size() != items.size()) {
+        Completion completion{{}, 0};
+        forEachMatching(prefix, [&](const MenuEntry& entry) {
+            completion.common = completion.matches ? commonPrefix(completion.common, entry.name()) : entry.name();
+            completion.matches++;
+        });
+        return completion;
+    }
+    const auto range = matchingRange(prefix);
+    if (range.empty()) return {{}, 0};
+    // names are sorted, so first and last one differ at most
+    return {commonPrefix(items[range.front()].name(), items[range.back()].name()), range.size()};
+}
+
+std::span<const uint16_t> SubMenuBase::matchingRange(std::string_view prefix) const noexcept {
+    auto first = std::lower_bound(index.begin(), index.end(), prefix,
+                                  [this](uint16_t position, std::string_view prefix) { return items[position].name() < prefix; });
+    auto last = std::partition_point(first, index.end(),
+                                     [this, prefix](uint16_t position) { return items[position].name().starts_with(prefix); });
+    return {first, last};
+}
+
+void SubMenuBase::buildIndex(std::span<const MenuEntry> items, std::span<uint16_t> index) noexcept {
+    std::iota(index.begin(), index.end(), 0);
+    std::sort(index.begin(), index.end(), [items](uint16_t a, uint16_t b) {
+        const auto compare = items[a].name().compare(items[b].name());
+        return compare < 0 || (compare == 0 && a < b);
+    });
+}
+
+void SubMenuBase::insertIntoIndex(std::span<const MenuEntry> items, std::span<uint16_t> index) noexcept {
+    const uint16_t last = items.size() - 1;
+    const auto name = items[last].name();
+    // upper bound keeps items with the same name in order of adding
+    auto position = std::upper_bound(index.begin(), index.end() - 1, name,
+                                     [items](std::string_view name, uint16_t position) { return name < items[position].name(); });
+    std::copy_backward(position, index.end() - 1, index.end());
+    *position = last;
+}
+
+#if !defined(CLI_HEAP_FREE)
+void SubMenu<std::dynamic_extent>::add(MenuEntry entry) {
+    itemsContainer.push_back(entry);
+    indexContainer.push_back(0);
+    insertIntoIndex(itemsContainer, indexContainer);
+    update();
+}
+#endif
+
+} /* namespace microhal */
 
 /**
  * components
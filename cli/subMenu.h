@@ -45,7 +45,10 @@
 #ifndef _CLI_SUBMENU_H_
 #define _CLI_SUBMENU_H_
 
+#include <array>
+#include <cstdint>
 #include <span>
+#include <type_traits>
 #include <vector>
 #include "IODevice/IODevice.h"
 #include "menuItem.h"
@@ -53,19 +56,119 @@
 namespace microhal {
 
 class MainMenuBase;
+class SubMenuBase;
+
+/**
+ * @brief Entry of sub menu items table: command handler or nested sub menu. Nested sub menus are referenced as const, so
+ *        whole menu structure (names, items tables and sub menus) may be declared constexpr and placed in read-only memory.
+ *        Only command handlers have to be mutable objects, they may be declared constinit so no code runs at startup:
+ *        @code
+ *        constinit ClockStatus status;
+ *        constinit ClockSet set;
+ *        constexpr SubMenu<2> clock("clock", status, set);
+ *        constexpr SubMenu<1> tree("", clock);
+ *        constinit MainMenuBase menu(console, tree);
+ *        @endcode
+ */
+class MenuEntry {
+ public:
+    constexpr MenuEntry() noexcept = default;
+    constexpr MenuEntry(MenuItem& handler) noexcept : item(&handler), handler(&handler) {}
+    constexpr MenuEntry(const SubMenuBase& subMenu) noexcept;
+    constexpr MenuEntry(SubMenuBase& subMenu) noexcept : MenuEntry(static_cast<const SubMenuBase&>(subMenu)) {}
+
+    [[nodiscard]] constexpr std::string_view name() const noexcept { return item->name; }
+    [[nodiscard]] constexpr bool isSubMenu() const noexcept { return handler == nullptr; }
+    /**
+     * @return Command handler, valid only when entry isn't sub menu.
+     */
+    [[nodiscard]] constexpr MenuItem& command() const noexcept { return *handler; }
+    /**
+     * @return Nested sub menu, valid only when entry is sub menu.
+     */
+    [[nodiscard]] constexpr const SubMenuBase& subMenu() const noexcept;
+
+ private:
+    const MenuItem* item = nullptr;
+    MenuItem* handler = nullptr;
+};
+
 /**
- * @brief Provides sub-folder functionalities.
+ * @brief Provides sub-folder functionalities. Every sub folder carries index of its items sorted by name, so command lookup
+ *        is a binary search instead of scanning all items. Index is built when sub folder is constructed at runtime. Names of
+ *        constinit command handlers can't be read during constant evaluation, so constexpr sub folders have no index and
+ *        fall back to linear search, big sub folders should be constructed at runtime (ex. as function static).
  */
 class SubMenuBase : public MenuItem {
     friend MainMenuBase;
 
+ public:
+    /**
+     * @brief Items which names start with given prefix.
+     */
+    struct Completion {
+        std::string_view common;  ///< longest common prefix of found item names
+        size_t matches;           ///< count of found items
+    };
+
+    /**
+     * @brief Looks for item of given name, doesn't execute it.
+     * @param name - item name.
+     * @return Pointer to found item or nullptr when there is no such item. When there are more items with the same name
+     *         first one is returned.
+     */
+    [[nodiscard]] const MenuEntry* find(std::string_view name) const noexcept;
+    /**
+     * @brief Looks for items which names start with given prefix. With index it takes binary search and comparison of first
+     *        and last found name.
+     * @param prefix - beginning of item name.
+     * @return Found items count and their longest common prefix, which starts with given prefix when anything was found.
+     */
+    [[nodiscard]] Completion complete(std::string_view prefix) const noexcept;
+    /**
+     * @brief Calls function for every item which name starts with given prefix, in name order when index was built.
+     * @param prefix - beginning of item name.
+     * @param function - function called with const MenuEntry reference.
+     */
+    template <typename Function>
+    void forEachMatching(std::string_view prefix, Function&& function) const {
+        if (index.size() != items.size()) {
+            for (const MenuEntry& entry : items) {
+                if (entry.name().starts_with(prefix)) function(entry);
+            }
+            return;
+        }
+        for (uint16_t position : matchingRange(prefix)) {
+            function(items[position]);
+        }
+    }
+
  protected:
     /**
      * @brief Constructs sub folder of given name and default help description.
      * @param name - sub folder name.
-     * @param help - default help description.
+     * @param items - sub folder content.
+     * @param index - positions of items sorted by name, may be empty.
      */
-    SubMenuBase(std::string_view name, std::span<MenuItem*> items) : MenuItem(name), items(items) {}
+    constexpr SubMenuBase(std::string_view name, std::span<const MenuEntry> items, std::span<const uint16_t> index = {}) noexcept
+        : MenuItem(name), items(items), index(index) {}
+
+    /**
+     * @brief Fills index with positions of items sorted by name, items with the same name keep their order.
+     * @param items - sub folder content.
+     * @param index - place for index, has to be the same size as items.
+     */
+    static void buildIndex(std::span<const MenuEntry> items, std::span<uint16_t> index) noexcept;
+    /**
+     * @brief Puts position of last item into index, items with the same name keep their order.
+     * @param items - sub folder content.
+     * @param index - index of all items but last one followed by free place, has to be the same size as items.
+     */
+    static void insertIntoIndex(std::span<const MenuEntry> items, std::span<uint16_t> index) noexcept;
+    /**
+     * @brief Part of index with items which names start with given prefix, index has to be built.
+     */
+    std::span<const uint16_t> matchingRange(std::string_view prefix) const noexcept;
 
     /**
      * @brief	Function for recognition whether it has children list or not.
@@ -76,48 +179,110 @@ class SubMenuBase : public MenuItem {
 
  protected:
     /**
-     * @brief Vector of object in sub folder.
+     * @brief Sub folder content.
+     */
+    std::span<const MenuEntry> items;
+    /**
+     * @brief Positions of items sorted by name, empty when index wasn't built.
      */
-    std::span<MenuItem*> items;
+    std::span<const uint16_t> index;
 };
 
+constexpr MenuEntry::MenuEntry(const SubMenuBase& subMenu) noexcept : item(&subMenu) {}
+
+constexpr const SubMenuBase& MenuEntry::subMenu() const noexcept {
+    return static_cast<const SubMenuBase&>(*item);
+}
+
 template <size_t size>
 class SubMenu : public SubMenuBase {
  public:
     template <typename... Args>
-    SubMenu(std::string_view name, Args&... args) : SubMenuBase(name, itemsContainer), itemsContainer({&args...}) {}
+    constexpr SubMenu(std::string_view name, Args&... args) noexcept : SubMenuBase(name, {}), itemsContainer{MenuEntry(args)...} {
+        static_assert(sizeof...(Args) <= size, "Too many items.");
+        static_assert(size <= UINT16_MAX, "Too many items.");
+        SubMenuBase::items = std::span<const MenuEntry>(itemsContainer).first(sizeof...(Args));
+        if (!std::is_constant_evaluated()) {
+            auto sortedIndex = std::span(indexContainer).first(sizeof...(Args));
+            buildIndex(SubMenuBase::items, sortedIndex);
+            SubMenuBase::index = sortedIndex;
+        }
+    }
+    // explicitly defaulted, implicit virtual destructor isn't usable in constant expressions on some compilers
+    constexpr ~SubMenu() override = default;
+
+    /**
+     * @brief Adds an MenuItem into sub folder, sub folder constructed with less than size items has place for more of them.
+     * @param item - MenuItem reference which should be added into sub folder.
+     * @return false when sub folder is full.
+     */
+    bool addItem(MenuItem& item) noexcept { return add(item); }
+    /**
+     * @brief Adds an SubMenu into sub folder, sub folder constructed with less than size items has place for more of them.
+     * @param item - SubMenu reference which should be added into sub folder.
+     * @return false when sub folder is full.
+     */
+    bool addItem(const SubMenuBase& item) noexcept { return add(item); }
 
  private:
-    std::array<MenuItem*, size> itemsContainer{};
+    std::array<MenuEntry, size> itemsContainer{};
+    std::array<uint16_t, size> indexContainer{};
+
+    bool add(MenuEntry entry) noexcept {
+        const size_t count = SubMenuBase::items.size();
+        if (count == size) return false;
+        itemsContainer[count] = entry;
+        SubMenuBase::items = std::span<const MenuEntry>(itemsContainer).first(count + 1);
+        auto sortedIndex = std::span(indexContainer).first(count + 1);
+        // sub folder constructed at compile time has no index yet
+        if (SubMenuBase::index.size() == count) {
+            insertIntoIndex(SubMenuBase::items, sortedIndex);
+        } else {
+            buildIndex(SubMenuBase::items, sortedIndex);
+        }
+        SubMenuBase::index = sortedIndex;
+        return true;
+    }
 };
 
+#if !defined(CLI_HEAP_FREE)
+/**
+ * @brief Sub folder without items count limit, it allocates memory when items are added. Not available when CLI_HEAP_FREE
+ *        is defined, then fixed size SubMenu has to be used.
+ */
 template <>
 class SubMenu<std::dynamic_extent> : public SubMenuBase {
  public:
     template <typename... Args>
-    SubMenu(std::string_view name, Args&... args) : SubMenuBase(name, itemsContainer), itemsContainer({&args...}) {}
+    SubMenu(std::string_view name, Args&... args) : SubMenuBase(name, {}), itemsContainer{MenuEntry(args)...} {
+        indexContainer.resize(itemsContainer.size());
+        buildIndex(itemsContainer, indexContainer);
+        update();
+    }
 
-    SubMenu(std::string_view name) : SubMenuBase(name, itemsContainer), itemsContainer({}) {}
+    SubMenu(std::string_view name) : SubMenuBase(name, {}), itemsContainer({}) {}
     /**
      * @brief Adds an MenuItem into sub folder.
      * @param item - MenuItem reference which should be added into sub folder.
      */
-    inline void addItem(MenuItem& item) {
-        itemsContainer.push_back(&item);
-        SubMenuBase::items = items;
-    }
+    inline void addItem(MenuItem& item) { add(item); }
     /**
      * @brief Adds an SubMenu into sub folder.
      * @param item - SubMenu reference which should be added into sub folder.
      */
-    inline void addItem(SubMenuBase& item) {
-        itemsContainer.push_back(&item);
-        SubMenuBase::items = items;
-    }
+    inline void addItem(const SubMenuBase& item) { add(item); }
 
  private:
-    std::vector<MenuItem*> itemsContainer{};
+    std::vector<MenuEntry> itemsContainer{};
+    std::vector<uint16_t> indexContainer{};
+
+    void add(MenuEntry entry);
+    void update() {
+        SubMenuBase::items = itemsContainer;
+        SubMenuBase::index = indexContainer;
+    }
 };
+#endif
 
 }  // namespace microhal
 
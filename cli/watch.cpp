@@ -0,0 +1,145 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Built-in watch command, reruns command and redraws only changed lines.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "watch.h"
+#include <algorithm>
+#include <charconv>
+#include "duration.h"
+#include "mainMenu.h"
+
+using namespace std::literals;
+
+namespace microhal {
+
+/**
+ * @brief Collects output of watched command into not shown screen.
+ */
+class WatchBase::Capture : public IODevice {
+ public:
+    explicit Capture(WatchBase &watch) noexcept : watch(watch) { watch.lengths[next()] = 0; }
+
+    int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+    void close() noexcept final {}
+    int isOpen() const noexcept final { return true; }
+    ssize_t read([[maybe_unused]] char *buffer, [[maybe_unused]] size_t length) noexcept final { return 0; }
+    ssize_t availableBytes() const noexcept final { return 0; }
+
+    /**
+     * @brief Stores data without CR chars, data that don't fit are dropped.
+     * @return Length of data, so command doesn't see cut output as write error.
+     */
+    ssize_t write(const char *data, size_t length) noexcept final {
+        char *screen = watch.screenData(next());
+        uint16_t &used = watch.lengths[next()];
+        for (size_t i = 0; i < length && used < watch.screenLength(); i++) {
+            if (data[i] != '\r') screen[used++] = data[i];
+        }
+        return length;
+    }
+
+ private:
+    WatchBase &watch;
+
+    uint_fast8_t next() const noexcept { return watch.shown ^ 1; }
+};
+
+namespace {
+/**
+ * @return Text up to new line char, which is removed from text together with the line.
+ */
+std::string_view takeLine(std::string_view &text) noexcept {
+    const size_t end = std::min(text.find('\n'), text.size());
+    const auto line = text.substr(0, end);
+    text.remove_prefix(std::min(end + 1, text.size()));
+    return line;
+}
+
+/**
+ * @brief Moves cursor vertically with ESC [ n A or ESC [ n B sequence.
+ */
+void moveCursor(IODevice &port, size_t from, size_t to) {
+    if (from == to) return;
+    char sequence[16] = "\x1b[";
+    const auto [end, error] = std::to_chars(&sequence[2], &sequence[sizeof(sequence) - 1], from > to ? from - to : to - from);
+    *end = from > to ? 'A' : 'B';
+    port.write(sequence, end - sequence + 1);
+}
+}  // namespace
+
+CommandTask WatchBase::execute(std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) {
+    const auto intervalText = parameters.substr(0, parameters.find(' '));
+    const auto commandLine = parameters.substr(std::min(intervalText.size() + 1, parameters.size()));
+    const auto interval = parseDuration(intervalText);
+    if (interval <= interval.zero() || commandLine.empty()) {
+        port.write("\tusage: watch <interval>[ms|s] <command>"sv);
+        co_return -1;
+    }
+
+    lengths[shown] = 0;
+    shownLines = 0;
+    while (true) {
+        Capture capture(*this);
+        const auto result = menu->processWatched(commandLine, capture);
+        if (result.status != MainMenuBase::Result::Status::Executed) {
+            // sub-folder is found, but it has no output to watch
+            port.write(result.status == MainMenuBase::Result::Status::MenuChanged ? "\tnot a command..."sv : "\tno such command..."sv);
+            co_return -1;
+        }
+        draw(port);
+        // any key pressed requests cancellation
+        if (!co_await sleep(interval)) co_return 0;
+    }
+}
+
+void WatchBase::draw(IODevice &port) {
+    std::string_view previous = screen(shown);
+    std::string_view current = screen(shown ^ 1);
+    size_t row = shownLines;
+    size_t line = 0;
+    for (; line < shownLines && !current.empty(); ++line) {
+        const auto text = takeLine(current);
+        if (text == takeLine(previous)) continue;
+        moveCursor(port, row, line);
+        row = line;
+        port.write("\r"sv);
+        port.write(text);
+        port.write("\x1b[K"sv);
+    }
+    moveCursor(port, row, line);
+    // cursor is at the end of redrawn line
+    if (row < shownLines) port.write("\r"sv);
+    // output got shorter, rest of old one is erased
+    if (line < shownLines) port.write("\x1b[J"sv);
+    for (; !current.empty(); ++line) {
+        port.write(takeLine(current));
+        port.write("\n\r"sv);
+    }
+    shownLines = line;
+    shown ^= 1;
+}
+
+}  // namespace microhal
@@ -0,0 +1,112 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Built-in watch command, reruns command and redraws only changed lines.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CLI_WATCH_H_
+#define _CLI_WATCH_H_
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "IODevice/IODevice.h"
+#include "coroutineMenuItem.h"
+
+namespace microhal {
+
+#define WATCHSCREENLENGTH 256
+
+class MainMenuBase;
+
+/**
+ * @brief `watch <interval> <command>` command, runs command every interval until any key is pressed. It is optional, an
+ *        application that wants it creates Watch object and passes it to MainMenuBase::setWatch.
+ *        Interval is given as parseDuration text: `watch 500ms clock status`. Command output is captured
+ *        and only lines that changed since previous run are sent, cursor is moved to them with VT100 sequences, so on slow
+ *        link monitoring costs only the changed bytes. Output longer than screen length is cut, lines should be shorter
+ *        than terminal width, otherwise wrapped lines shift the redrawn ones.
+ */
+class WatchBase : public CoroutineMenuItem {
+    friend MainMenuBase;
+
+ public:
+    WatchBase(const WatchBase &) = delete;
+    WatchBase &operator=(const WatchBase &) = delete;
+
+    CommandTask execute(std::string_view parameters, IODevice &port, const CancellationToken &token) final;
+
+ protected:
+    /**
+     * @param buffer - storage for two screens of captured output.
+     */
+    constexpr explicit WatchBase(std::span<char> buffer) noexcept : CoroutineMenuItem("watch"), buffer(buffer) {}
+
+ private:
+    class Capture;
+
+    /**
+     * @brief Menu that runs watched command, set by MainMenuBase::setWatch.
+     */
+    MainMenuBase *menu = nullptr;
+    /**
+     * @brief Output of last two runs, without CR chars. Screen indexed by shown is visible on console.
+     */
+    std::span<char> buffer;
+    uint16_t lengths[2]{};
+    uint8_t shown = 0;
+    /**
+     * @brief Count of lines visible on console, cursor waits at the beginning of line below them.
+     */
+    uint16_t shownLines = 0;
+
+    [[nodiscard]] size_t screenLength() const noexcept { return buffer.size() / 2; }
+    [[nodiscard]] char *screenData(uint_fast8_t index) const noexcept { return buffer.data() + index * screenLength(); }
+    [[nodiscard]] std::string_view screen(uint_fast8_t index) const noexcept { return {screenData(index), lengths[index]}; }
+    /**
+     * @brief Sends lines of captured screen that differ from shown one, then captured screen becomes shown.
+     * @param port - console port.
+     */
+    void draw(IODevice &port);
+};
+
+/**
+ * @brief Watch command with storage for captured output.
+ * @tparam length - maximal length of captured output of one command run.
+ */
+template <size_t length = WATCHSCREENLENGTH>
+class Watch : public WatchBase {
+    static_assert(length <= UINT16_MAX, "Screen length doesn't fit into length counters.");
+
+ public:
+    constexpr Watch() noexcept : WatchBase(storage) {}
+
+ private:
+    std::array<char, 2 * length> storage{};
+};
+
+}  // namespace microhal
+
+#endif /* _CLI_WATCH_H_ */
@@ -66,7 +66,7 @@ using namespace microhal;
 
 class MemorySave : public MenuItem {
  public:
-    MemorySave(void) : MenuItem("save") {}
+    constexpr MemorySave(void) : MenuItem("save") {}
     static void memorySave(IODevice& port) { port.write("Memory saved!!!"); }
 
  protected:
@@ -78,7 +78,7 @@ class MemorySave : public MenuItem {
 
 class MemoryRestore : public MenuItem {
  public:
-    MemoryRestore(void) : MenuItem("restore") {}
+    constexpr MemoryRestore(void) : MenuItem("restore") {}
     static void memoryRestore(IODevice& port) { port.write("Memory restored!!!"); }
 
  protected:
@@ -94,7 +94,7 @@ class Car : public MenuItem {
     static float maxSpeed;
     static int gearsCnt;
 
-    Car(std::string_view name) : MenuItem(name) {}
+    constexpr Car(std::string_view name) : MenuItem(name) {}
 
  protected:
     void setColor(std::string_view color) {
@@ -109,7 +109,7 @@ int Car::gearsCnt = -1;
 
 class CarSet : public Car {
  public:
-    CarSet(void) : Car("set") {}
+    constexpr CarSet(void) : Car("set") {}
 
  protected:
     int execute(std::string_view parameters, IODevice& port) final {
@@ -141,7 +141,7 @@ class CarSet : public Car {
 
 class CarPrint : public Car {
  public:
-    CarPrint(void) : Car("get") {}
+    constexpr CarPrint(void) : Car("get") {}
 
  protected:
     int execute([[maybe_unused]] std::string_view parameters, IODevice& port) final {
@@ -157,7 +157,7 @@ class CarPrint : public Car {
 
 class Clock : public MenuItem {
  public:
-    Clock(std::string_view name) : MenuItem(name) {}
+    constexpr Clock(std::string_view name) : MenuItem(name) {}
 
     static int hours, minutes, seconds;
     static bool alarm;
@@ -170,7 +170,7 @@ bool Clock::alarm = false;
 
 class AlarmOff : public Clock {
  public:
-    AlarmOff(void) : Clock("off") {}
+    constexpr AlarmOff(void) : Clock("off") {}
     static void alarmOff(IODevice& port) {
         alarm = false;
         port.write("AlarmOff");
@@ -185,7 +185,7 @@ class AlarmOff : public Clock {
 
 class AlarmOn : public Clock {
  public:
-    AlarmOn(void) : Clock("on") {}
+    constexpr AlarmOn(void) : Clock("on") {}
     static void alarmOn(IODevice& port) {
         alarm = true;
         port.write("AlarmOn");
@@ -200,7 +200,7 @@ class AlarmOn : public Clock {
 
 class ClockStatus : public Clock {
  public:
-    ClockStatus(void) : Clock("status") {}
+    constexpr ClockStatus(void) : Clock("status") {}
     static void clockStatus(IODevice& port) {
         char str[25];
         snprintf(str, 25, "%02d:%02d:%02d\n", hours, minutes, seconds);
@@ -220,7 +220,7 @@ class ClockStatus : public Clock {
 
 class ClockSet : public Clock {
  public:
-    ClockSet(void) : Clock("set") {}
+    constexpr ClockSet(void) : Clock("set") {}
 
  protected:
     int execute(std::string_view parameters, IODevice& port) final {
@@ -243,6 +243,27 @@ class ClockSet : public Clock {
     }
 };
 
+// Whole menu tree is built at compile time: sub menus are constexpr, so they are placed in read-only memory together with
+// their item tables, command handlers are constinit so no constructor runs before main.
+constinit CarPrint carPrint;
+constinit CarSet carSet;
+constexpr SubMenu<2> _car("car", carPrint, carSet);
+
+constexpr SubMenu<1> _recursiveEmptySet("empty");
+constexpr SubMenu<1> _emptySet("empty", _recursiveEmptySet);
+
+constinit AlarmOn aon;
+constinit AlarmOff aoff;
+constexpr SubMenu<2> _alarm("alarm", aon, aoff);
+
+constinit ClockStatus cstat;
+constinit ClockSet cset;
+constexpr SubMenu<3> _clock("clock", cstat, cset, _alarm);
+
+constinit MemorySave ms;
+constinit MemoryRestore mr;
+constexpr SubMenu<2> _memory("memory", ms, mr);
+
 /**
  * @brief   Main function of example CLI project. Consist of menu initialization and
  *          CLI chars reading loop.
@@ -251,32 +272,14 @@ class ClockSet : public Clock {
 int main(void) {
     debugPort.open(IODevice::ReadWrite);
 
-    CarPrint carPrint;
-    CarSet carSet;
-    SubMenu<2> _car("car", carPrint, carSet);
-
-    SubMenu<1> _recursiveEmptySet("empty");
-    SubMenu<1> _emptySet("empty", _recursiveEmptySet);
-
-    AlarmOn aon;
-    AlarmOff aoff;
-    SubMenu<2> _alarm("alarm", aon, aoff);
-
-    ClockStatus cstat;
-    ClockSet cset;
-    SubMenu<3> _clock("clock", cstat, cset, _alarm);
-
-    MemorySave ms;
-    MemoryRestore mr;
-    SubMenu<2> _memory("memory", ms, mr);
-
+    // console port is a reference known only at run time, so main menu is created here
     MainMenu<4> _root(debugPort, _clock, _car, _emptySet, _memory);
     CLI cli(debugPort, _root, "\n\r---------------------------- CLI DEMO -----------------------------\n\r");
 
-    std::chrono::milliseconds dura(100);
     while (1) {
+        // running command is resumed and finished by readInput, so it is polled often, idle console only waits for a key
+        waitForConsoleInput(std::chrono::milliseconds{cli.commandRunning() ? 1 : 1000});
         cli.readInput();
-        std::this_thread::sleep_for(dura);
     }
     return 0;
 }
@@ -5,9 +5,17 @@
  *      Author: pokas
  */
 
+#include <poll.h>
+#include <unistd.h>
 #include <ports/linux/General/consoleIODevice_linux.h>
 #include "microhal_bsp.h"
 
 using namespace microhal;
 
 microhal::IODevice &debugPort = linux::consoleIODev;
+
+bool waitForConsoleInput(std::chrono::milliseconds timeout) {
+    // console device reads from standard input, sleep in kernel until it becomes readable
+    pollfd console{STDIN_FILENO, POLLIN, 0};
+    return poll(&console, 1, timeout.count()) > 0;
+}
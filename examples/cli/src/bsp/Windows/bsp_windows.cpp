@@ -26,9 +26,20 @@
 
  *//* ========================================================================================================================== */
 
+#include <thread>
 #include "serialPort_windows.h"
 #include "consoleIODevice.h"
+#include "microhal_bsp.h"
 
 using namespace microhal;
 
 microhal::IODevice &debugPort = windows::consoleIODev;
+
+bool waitForConsoleInput(std::chrono::milliseconds timeout) {
+    const auto timeoutTime = std::chrono::steady_clock::now() + timeout;
+    while (debugPort.availableBytes() == 0) {
+        if (std::chrono::steady_clock::now() >= timeoutTime) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
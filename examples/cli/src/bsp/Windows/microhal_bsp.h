@@ -29,6 +29,14 @@
 #ifndef WINDOWS_BSP_H_
 #define WINDOWS_BSP_H_
 
+#include <chrono>
+
 extern  microhal::IODevice &debugPort;
 
+/**
+ * @brief Blocks until console has data to read or timeout expires.
+ * @return true if data are available.
+ */
+bool waitForConsoleInput(std::chrono::milliseconds timeout);
+
 #endif /* STM32F4DISCOVERY_H_ */
@@ -26,6 +26,7 @@
 
  *//* ========================================================================================================================== */
 
+#include <thread>
 #include "SPIDevice/SPIDevice.h"
 #include "i2c.h"
 #include "microhal.h"
@@ -56,3 +57,12 @@ uint64_t SysTick_time = 0;
 extern "C" void SysTick_Handler(void) {
     SysTick_time++;
 }
+
+bool waitForConsoleInput(std::chrono::milliseconds timeout) {
+    const auto timeoutTime = std::chrono::steady_clock::now() + timeout;
+    while (debugPort.availableBytes() == 0) {
+        if (std::chrono::steady_clock::now() >= timeoutTime) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
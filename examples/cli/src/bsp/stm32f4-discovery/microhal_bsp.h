@@ -29,10 +29,17 @@
 #ifndef STM32F4DISCOVERY_H_
 #define STM32F4DISCOVERY_H_
 
+#include <chrono>
 #include "i2c.h"
 
 static microhal::SerialPort &debugPort = microhal::stm32f4xx::SerialPort::Serial3;
 
+/**
+ * @brief Blocks until console has data to read or timeout expires.
+ * @return true if data are available.
+ */
+bool waitForConsoleInput(std::chrono::milliseconds timeout);
+
 constexpr microhal::IOPin Led3(microhal::stm32f4xx::GPIO::Port::PortD, 13);
 constexpr microhal::IOPin Led4(microhal::stm32f4xx::GPIO::Port::PortD, 12);
 constexpr microhal::IOPin Led5(microhal::stm32f4xx::GPIO::Port::PortD, 14);
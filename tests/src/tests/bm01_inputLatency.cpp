@@ -0,0 +1,125 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CLI.h"
+#include "fdIODevice.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+void readExactly(int fd, size_t count) {
+    char buffer[64];
+    while (count) {
+        const auto received = ::read(fd, buffer, std::min(count, sizeof(buffer)));
+        if (received <= 0) break;
+        count -= received;
+    }
+}
+}  // namespace
+
+TEST_CASE("Benchmark keystroke to echo latency" * doctest::skip()) {
+    int input[2], output[2];
+    REQUIRE(pipe(input) == 0);
+    REQUIRE(pipe(output) == 0);
+    FdIODevice console(input[0], output[1]);
+    Item item("item");
+    MainMenu<1> root(console, item);
+    CLI cli(console, root);
+    readExactly(output[0], "\n\r> "sv.size());
+
+    std::atomic<bool> run = true;
+    std::thread cliThread([&] {
+        while (run) {
+            if (console.waitForInput(10ms)) cli.readInput();
+        }
+    });
+
+    constexpr size_t keystrokes = 5000;
+    std::vector<std::chrono::nanoseconds> latency;
+    latency.reserve(keystrokes);
+    for (size_t i = 0; i < keystrokes; i++) {
+        // type a char and remove it, line never overflows
+        const bool erase = i % 2;
+        const char sign = erase ? '\b' : 'a';
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE(::write(input[1], &sign, 1) == 1);
+        readExactly(output[0], erase ? 3 : 1);
+        latency.push_back(std::chrono::steady_clock::now() - start);
+    }
+    run = false;
+    cliThread.join();
+
+    std::sort(latency.begin(), latency.end());
+    MESSAGE("keystroke to echo latency [us]: median " << latency[keystrokes / 2].count() / 1000.0 << ", p99 "
+                                                      << latency[keystrokes * 99 / 100].count() / 1000.0 << ", max "
+                                                      << latency.back().count() / 1000.0);
+    for (auto fd : {input[0], input[1], output[0], output[1]}) close(fd);
+}
+
+TEST_CASE("Benchmark sustained input rate" * doctest::skip()) {
+    int input[2];
+    REQUIRE(pipe(input) == 0);
+    const int output = open("/dev/null", O_WRONLY);
+    FdIODevice console(input[0], output);
+    Item item("item");
+    MainMenu<1> root(console, item);
+    CLI cli(console, root);
+
+    std::string payload;
+    while (payload.size() < 4 * 1024 * 1024) payload += "pasted command with some parameters -a 12 --b 34\r";
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread writer([&] {
+        size_t written = 0;
+        while (written < payload.size()) {
+            const auto result = ::write(input[1], payload.data() + written, payload.size() - written);
+            if (result <= 0) break;
+            written += result;
+        }
+    });
+    while (console.bytesRead < payload.size()) {
+        if (console.waitForInput(100ms)) cli.readInput();
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    writer.join();
+
+    MESSAGE("sustained input rate: " << payload.size() / time.count() / 1024 << " kB/s");
+    for (auto fd : {input[0], input[1], output}) close(fd);
+}
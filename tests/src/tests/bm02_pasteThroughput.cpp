@@ -0,0 +1,94 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "CLI.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+/**
+ * Serves pasted text in reads of at most readSize bytes, discards output.
+ */
+class PasteDevice : public IODevice {
+ public:
+    PasteDevice(std::string_view text, size_t readSize) : text(text), readSize(readSize) {}
+
+    int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+    void close() noexcept final {}
+    int isOpen() const noexcept final { return true; }
+
+    ssize_t read(char *buffer, size_t length) noexcept final {
+        length = std::min({length, readSize, text.size()});
+        text.copy(buffer, length);
+        text.remove_prefix(length);
+        return length;
+    }
+    ssize_t availableBytes() const noexcept final { return text.size(); }
+    ssize_t write([[maybe_unused]] const char *data, size_t length) noexcept final { return length; }
+
+    void rewind(std::string_view pasted) { text = pasted; }
+
+ private:
+    std::string_view text;
+    size_t readSize;
+};
+
+double pasteThroughput(std::string_view script, size_t readSize) {
+    PasteDevice console(script, readSize);
+    Item item("item");
+    MainMenu<1> root(console, item);
+    CLI cli(console, root);
+
+    constexpr int repetitions = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+        console.rewind(script);
+        while (console.availableBytes()) cli.readInput();
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return script.size() * repetitions / time.count() / (1024 * 1024);
+}
+}  // namespace
+
+TEST_CASE("Benchmark pasted script throughput" * doctest::skip()) {
+    std::string script;
+    // 500 line provisioning script
+    for (int line = 0; line < 500; line++) {
+        script += "network interface eth0 set --ip 192.168.1." + std::to_string(line % 250) + " --mask 255.255.255.0\r\n";
+    }
+    MESSAGE("pasted input, bulk scanner: " << pasteThroughput(script, INPUTCHUNKLENGTH) << " MB/s");
+    MESSAGE("pasted input, one char per read: " << pasteThroughput(script, 1) << " MB/s");
+}
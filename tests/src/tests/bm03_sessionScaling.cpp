@@ -0,0 +1,139 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "fdIODevice.h"
+#include "sessionMultiplexer.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Executed>;
+
+struct Session {
+    Session(int master, int slave, SubMenuBase &tree) : master(master), slave(slave), console(slave, slave), menu(console, tree), cli(console, menu) {}
+    ~Session() {
+        close(slave);
+        close(master);
+    }
+
+    int master;
+    int slave;
+    FdIODevice console;
+    MainMenuBase menu;
+    CLI<> cli;
+};
+
+std::unique_ptr<Session> openSession(SubMenuBase &tree) {
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) || unlockpt(master)) return {};
+    const int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0) return {};
+    termios attributes;
+    tcgetattr(slave, &attributes);
+    cfmakeraw(&attributes);
+    tcsetattr(slave, TCSANOW, &attributes);
+    return std::make_unique<Session>(master, slave, tree);
+}
+
+void readUntilPrompt(int fd) {
+    char buffer[256];
+    size_t size = 0;
+    while (size < 2 || std::string_view(buffer + size - 2, 2) != "> "sv) {
+        const auto received = read(fd, buffer + size, sizeof(buffer) - size);
+        if (received <= 0) return;
+        size += received;
+        if (size == sizeof(buffer)) {
+            buffer[0] = buffer[size - 2];
+            buffer[1] = buffer[size - 1];
+            size = 2;
+        }
+    }
+}
+
+void benchmarkSessions(size_t sessionsCount) {
+    Item status("status"), reboot("reboot");
+    SubMenu<1> clock("clock", status);
+    SubMenu<2> tree("", clock, reboot);
+
+    std::vector<std::unique_ptr<Session>> sessions;
+    SessionMultiplexer<256> multiplexer;
+    std::vector<pollfd> descriptors;
+    for (size_t i = 0; i < sessionsCount; i++) {
+        auto session = openSession(tree);
+        REQUIRE(session);
+        readUntilPrompt(session->master);
+        multiplexer.add(session->cli);
+        descriptors.push_back({session->slave, POLLIN, 0});
+        sessions.push_back(std::move(session));
+    }
+
+    // single event loop serving all sessions
+    std::atomic<bool> run = true;
+    std::thread eventLoop([&] {
+        while (run) {
+            if (poll(descriptors.data(), descriptors.size(), 10) <= 0) continue;
+            for (size_t i = 0; i < descriptors.size(); i++) {
+                if (descriptors[i].revents & POLLIN) multiplexer.readInput(i);
+            }
+        }
+    });
+
+    constexpr size_t rounds = 200;
+    constexpr auto command = "reboot\r"sv;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) {
+        for (auto &session : sessions) REQUIRE(write(session->master, command.data(), command.size()) == ssize_t(command.size()));
+        for (auto &session : sessions) readUntilPrompt(session->master);
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    run = false;
+    eventLoop.join();
+
+    MESSAGE(sessionsCount << " sessions: " << rounds * sessionsCount / time.count() << " commands/s, round trip of all sessions "
+                          << time.count() / rounds * 1e6 << " us");
+}
+}  // namespace
+
+TEST_CASE("Benchmark multiplexed sessions on ptys" * doctest::skip()) {
+    benchmarkSessions(1);
+    benchmarkSessions(16);
+    benchmarkSessions(256);
+}
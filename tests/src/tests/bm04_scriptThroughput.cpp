@@ -0,0 +1,119 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "CLI.h"
+#include "scriptRunner.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Name>;
+
+/**
+ * Serves script in reads of at most INPUTCHUNKLENGTH bytes, discards output.
+ */
+class ScriptDevice : public IODevice {
+ public:
+    int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+    void close() noexcept final {}
+    int isOpen() const noexcept final { return true; }
+
+    ssize_t read(char *buffer, size_t length) noexcept final {
+        length = std::min({length, size_t{INPUTCHUNKLENGTH}, text.size()});
+        text.copy(buffer, length);
+        text.remove_prefix(length);
+        return length;
+    }
+    ssize_t availableBytes() const noexcept final { return text.size(); }
+    ssize_t write([[maybe_unused]] const char *data, size_t length) noexcept final {
+        bytesWritten += length;
+        return length;
+    }
+
+    std::string_view text;
+    size_t bytesWritten = 0;
+};
+
+constexpr int commands = 1000;
+constexpr int repetitions = 20;
+
+std::string makeScript() {
+    std::string script;
+    for (int line = 0; line < commands; line++) {
+        script += "set --ip 192.168.1." + std::to_string(line % 250) + "\r\n";
+    }
+    return script;
+}
+
+template <typename Function>
+double commandsPerSecond(Function &&runScript) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        runScript();
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return commands * repetitions / time.count();
+}
+}  // namespace
+
+TEST_CASE("Benchmark script execution against interactive console" * doctest::skip()) {
+    const auto script = makeScript();
+    Item set("set");
+
+    ScriptDevice console;
+    MainMenu<1> interactiveRoot(console, set);
+    CLI cli(console, interactiveRoot);
+    console.bytesWritten = 0;
+    const double interactive = commandsPerSecond([&] {
+        console.text = script;
+        while (console.availableBytes())
+            cli.readInput();
+    });
+    const size_t interactiveBytes = console.bytesWritten / repetitions;
+
+    ScriptDevice output;
+    MainMenu<1> batchRoot(output, set);
+    ScriptRunner runner(batchRoot);
+    const double batch = commandsPerSecond([&] { runner.run(script); });
+    const size_t batchBytes = output.bytesWritten / repetitions;
+
+    ScriptDevice stream;
+    const double batchStream = commandsPerSecond([&] {
+        stream.text = script;
+        runner.run(stream);
+    });
+
+    // on serial console output size matters more than CPU time
+    MESSAGE("interactive console: " << interactive << " commands/s, " << interactiveBytes / commands << " bytes of output per command");
+    MESSAGE("script from memory: " << batch << " commands/s, " << batchBytes / commands << " bytes of output per command");
+    MESSAGE("script from stream: " << batchStream << " commands/s");
+}
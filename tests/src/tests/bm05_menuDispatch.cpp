@@ -0,0 +1,95 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+/**
+ * Menu level with generated register like names, ex. "reg0042".
+ */
+struct GeneratedMenu {
+    explicit GeneratedMenu(size_t count) : menu(device, sub) {
+        for (size_t i = 0; i < count; i++) {
+            names.push_back("reg" + std::to_string(1000 + i).substr(1));
+        }
+        // declaration order differs from sorted order
+        std::reverse(names.begin(), names.end());
+        for (const auto &name : names) {
+            sub.addItem(items.emplace_back(name));
+        }
+    }
+
+    CountingIODevice device;
+    std::vector<std::string> names;
+    std::deque<Item> items;
+    SubMenu<std::dynamic_extent> sub{""};
+    MainMenuBase menu;
+};
+
+constexpr size_t lookups = 1'000'000;
+
+template <typename Function>
+double nanosecondsPerLookup(const std::vector<std::string> &names, Function &&lookup) {
+    size_t found = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        found += lookup(names[(i * 7919) % names.size()]);
+    }
+    const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    REQUIRE(found == lookups);
+    return time.count() / lookups;
+}
+}  // namespace
+
+TEST_CASE("Benchmark command dispatch against sub menu size" * doctest::skip()) {
+    for (size_t count : {10, 100, 1000}) {
+        GeneratedMenu generated(count);
+        // previous implementation: compare command with every item name
+        const double linear = nanosecondsPerLookup(generated.names, [&](std::string_view command) {
+            return std::find_if(generated.items.begin(), generated.items.end(), [command](const Item &item) { return item.name == command; }) !=
+                   generated.items.end();
+        });
+        const double indexed = nanosecondsPerLookup(generated.names, [&](std::string_view command) { return generated.sub.find(command) != nullptr; });
+        const double dispatch = nanosecondsPerLookup(generated.names, [&](std::string_view command) {
+            return generated.menu.processCommand(command, MainMenuBase::Mode::Batch).status == MainMenuBase::Result::Status::Executed;
+        });
+        MESSAGE(count << " items: linear scan " << linear << " ns, indexed lookup " << indexed << " ns, processCommand " << dispatch << " ns");
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include "IODevice/ioDeviceNull/IODeviceNull.h"
+#include "parsers/argumentParser.h"
+#include "parsers/flagParser.h"
+#include "parsers/numericParser.h"
+#include "parsers/stringParser.h"
+
+using namespace microhal;
+using namespace cli;
+using namespace std::literals;
+
+namespace {
+constexpr size_t iterations = 1'000'000;
+constexpr std::string_view parameters = "-b 115200 --dataBits 8 -v"sv;
+
+template <typename Function>
+double nanosecondsPerParse(Function &&parse) {
+    size_t succeeded = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        succeeded += parse() == Status::Success;
+    }
+    const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    REQUIRE(succeeded == iterations);
+    return time.count() / iterations;
+}
+}  // namespace
+
+TEST_CASE("Benchmark compile time argument parser against runtime parser" * doctest::skip()) {
+    static constexpr const NumericParser<uint32_t> baud('b', "baudrate", "baud", Parameter::Flag::Optional, "Baudrate", 10, 200000);
+    static constexpr const NumericParser<uint8_t> dataBits(-1, "dataBits", "data_bits", Parameter::Flag::Optional, "Data bits count.", 1, 9);
+    static constexpr const FlagParser verbose('v', "verbose", Parameter::Flag::Optional, "Print details.");
+    ArgumentParser<baud, dataBits, verbose> parser("USART", "USART configuration.");
+
+    NumericParser<uint32_t> runtimeBaud('b', "baudrate", "baud", "Baudrate", 10, 200000);
+    NumericParser<uint8_t> runtimeDataBits(-1, "dataBits", "data_bits", "Data bits count.", 1, 9);
+    FlagParser runtimeVerbose('v', "verbose", "Print details.");
+    RuntimeArgumentParser<3> runtimeParser("USART", "USART configuration.");
+    runtimeParser.addArgument(runtimeBaud);
+    runtimeParser.addArgument(runtimeDataBits);
+    runtimeParser.addArgument(runtimeVerbose);
+
+    IODeviceNull ioDevice;
+    const double runtime = nanosecondsPerParse([&] { return runtimeParser.parse(parameters, ioDevice); });
+    const double compileTime = nanosecondsPerParse([&] { return parser.parse(parameters, ioDevice); });
+    MESSAGE("runtime parser " << runtime << " ns, " << sizeof(runtimeParser) + sizeof(runtimeBaud) + sizeof(runtimeDataBits) + sizeof(runtimeVerbose)
+                              << " B RAM; compile time parser " << compileTime << " ns, " << sizeof(parser) << " B RAM");
+}
+
+TEST_CASE("Benchmark parse time against command line length" * doctest::skip()) {
+    static constexpr const NumericParser<int32_t> offset('o', "offset", "offset", Parameter::Flag::Optional, "Offset", -100, 100);
+    static constexpr const StringParser label(-1, "label", "text", Parameter::Flag::Optional, "Port label.", 1, 40);
+    ArgumentParser<offset, label> parser("PORT", "Port configuration.");
+
+    IODeviceNull ioDevice;
+    for (size_t count : {1, 3, 7}) {
+        std::string line;
+        for (size_t i = 0; i < count; i++) {
+            line += i % 2 ? "  --label \"quoted - text\"" : "  --offset -42";
+        }
+        const double time = nanosecondsPerParse([&] { return parser.parse(line, ioDevice); });
+        MESSAGE(line.size() << " characters: " << time << " ns, " << time / line.size() << " ns/character");
+    }
+}
+
+namespace {
+constexpr std::array<std::string_view, 24> optionNames{"opt00", "opt01", "opt02", "opt03", "opt04", "opt05", "opt06", "opt07",
+                                                       "opt08", "opt09", "opt10", "opt11", "opt12", "opt13", "opt14", "opt15",
+                                                       "opt16", "opt17", "opt18", "opt19", "opt20", "opt21", "opt22", "opt23"};
+
+template <size_t index>
+constexpr const NumericParser<uint16_t> option(-1, optionNames[index], optionNames[index], Parameter::Flag::Optional, "Option.", 0, 1000);
+
+template <size_t... index>
+double templateParserTime(std::string_view line, IODevice &ioDevice, std::index_sequence<index...>) {
+    ArgumentParser<option<index>...> parser("CMD", "Command.");
+    return nanosecondsPerParse([&] { return parser.parse(line, ioDevice); });
+}
+}  // namespace
+
+TEST_CASE("Benchmark option dispatch with many arguments" * doctest::skip()) {
+    std::deque<NumericParser<uint16_t>> runtimeOptions;
+    RuntimeArgumentParser<optionNames.size()> runtimeParser("CMD", "Command.");
+    for (auto name : optionNames) {
+        runtimeParser.addArgument(runtimeOptions.emplace_back(-1, name, name, "Option.", 0, 1000));
+    }
+
+    // every option is given, from the last registered one, which is the worst case of linear search
+    std::string line;
+    for (size_t i = optionNames.size(); i > 0; i--) {
+        line += " --";
+        line += optionNames[i - 1];
+        line += ' ';
+        line += std::to_string(i);
+    }
+    IODeviceNull ioDevice;
+    const double runtime = nanosecondsPerParse([&] { return runtimeParser.parse(line, ioDevice); });
+    const double compileTime = templateParserTime(line, ioDevice, std::make_index_sequence<optionNames.size()>{});
+    MESSAGE(optionNames.size() << " arguments: runtime parser " << runtime << " ns, compile time parser " << compileTime << " ns");
+}
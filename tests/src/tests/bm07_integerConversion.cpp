@@ -0,0 +1,109 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <charconv>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "parsers/integerConversion.h"
+
+using namespace microhal;
+using namespace cli;
+
+namespace {
+constexpr size_t samples = 4096;
+constexpr size_t rounds = 64;
+
+template <typename Type>
+std::vector<std::string> randomNumbers(int base, bool fullWidth) {
+    std::mt19937_64 random(7);
+    std::vector<std::string> numbers;
+    for (size_t i = 0; i < samples; i++) {
+        // numbers of every length that fits type or numbers as long as type allows
+        const auto value = static_cast<Type>(fullWidth ? random() | (uint64_t{1} << (sizeof(Type) * 8 - 2)) : random() >> (random() % (sizeof(Type) * 8)));
+        char text[80];
+        const auto [end, error] = std::to_chars(std::begin(text), std::end(text), value, base);
+        REQUIRE(error == std::errc());
+        numbers.emplace_back(text, end);
+    }
+    return numbers;
+}
+
+/**
+ * @return The best time of a few repetitions, to reduce noise of other processes.
+ */
+template <typename Function>
+double nanosecondsPerNumber(const std::vector<std::string> &numbers, Function &&convert) {
+    double best = std::numeric_limits<double>::max();
+    for (int repetition = 0; repetition < 5; repetition++) {
+        uint64_t sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; round++) {
+            for (const auto &number : numbers) {
+                sum += convert(number);
+            }
+        }
+        const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+        REQUIRE(sum != 0);
+        best = std::min(best, time.count() / (rounds * numbers.size()));
+    }
+    return best;
+}
+
+template <typename Type>
+void compareWithFromChars(const char *typeName) {
+    constexpr Type min = std::numeric_limits<Type>::min();
+    constexpr Type max = std::numeric_limits<Type>::max();
+    for (auto [base, fullWidth] : {std::pair{10, false}, std::pair{10, true}, std::pair{16, false}, std::pair{16, true}}) {
+        const auto numbers = randomNumbers<Type>(base, fullWidth);
+        const double fromChars = nanosecondsPerNumber(numbers, [base](std::string_view number) {
+            Type value;
+            const auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), value, base);
+            // the same checks that were done after from_chars
+            if (error != std::errc() || value > max || value < min) return Type{};
+            return value;
+        });
+        const double kernel = nanosecondsPerNumber(numbers, [base](std::string_view number) {
+            return implementationDetail::toInteger<Type>(number, base, min, max).first;
+        });
+        MESSAGE(typeName << " base " << base << (fullWidth ? " full width" : " any width") << ": from_chars " << fromChars << " ns, toInteger " << kernel << " ns");
+    }
+}
+}  // namespace
+
+TEST_CASE("Benchmark integer conversion against from_chars" * doctest::skip()) {
+    compareWithFromChars<uint8_t>("uint8_t");
+    compareWithFromChars<int16_t>("int16_t");
+    compareWithFromChars<uint32_t>("uint32_t");
+    compareWithFromChars<int32_t>("int32_t");
+    compareWithFromChars<uint64_t>("uint64_t");
+    compareWithFromChars<int64_t>("int64_t");
+}
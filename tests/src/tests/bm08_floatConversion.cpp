@@ -0,0 +1,100 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <string_view>
+#include "parsers/floatConversion.h"
+
+using namespace microhal;
+using namespace cli;
+using namespace std::literals;
+
+namespace {
+constexpr size_t rounds = 200'000;
+
+/**
+ * @return The best time of a few repetitions, to reduce noise of other processes.
+ */
+template <typename Function>
+double nanosecondsPerNumber(std::span<const std::string_view> numbers, Function &&convert) {
+    double best = std::numeric_limits<double>::max();
+    for (int repetition = 0; repetition < 5; repetition++) {
+        double sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; round++) {
+            for (auto number : numbers) {
+                sum += convert(number);
+            }
+        }
+        const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+        REQUIRE(sum != 0);
+        best = std::min(best, time.count() / (rounds * numbers.size()));
+    }
+    return best;
+}
+
+// previous implementation: copy to buffer and use locale dependent strtod
+template <typename Type>
+Type bufferedStrtod(std::string_view number) {
+    std::array<char, 30> buffer;
+    if (number.size() >= buffer.size()) return 0;
+    std::copy_n(number.begin(), number.size(), buffer.data());
+    buffer[number.size()] = 0;
+    char *end;
+    return std::is_same_v<Type, float> ? std::strtof(buffer.data(), &end) : std::strtod(buffer.data(), &end);
+}
+
+template <typename Type>
+void compareFloatConversions(const char *typeName, const char *setName, std::span<const std::string_view> numbers) {
+    constexpr Type max = std::numeric_limits<Type>::max();
+    const double strtod = nanosecondsPerNumber(numbers, bufferedStrtod<Type>);
+    const double fromChars = nanosecondsPerNumber(numbers, [](std::string_view number) {
+        Type value{};
+        std::from_chars(number.data(), number.data() + number.size(), value);
+        return value;
+    });
+    const double converted = nanosecondsPerNumber(numbers, [](std::string_view number) { return implementationDetail::toFloatingPoint(number, -max, max).first; });
+    MESSAGE(typeName << " " << setName << ": strtod " << strtod << " ns, from_chars " << fromChars << " ns, toFloatingPoint " << converted << " ns");
+}
+}  // namespace
+
+TEST_CASE("Benchmark floating point conversion" * doctest::skip()) {
+    static constexpr std::array shortNumbers{"12.5"sv, "0.001"sv, "3.14159"sv, "-40"sv, "1e-3"sv, "115200"sv, "0.75"sv, "-273.15"sv};
+    static constexpr std::array longNumbers{"3.141592653589793238"sv, "2.718281828459045e-100"sv, "6.02214076e23"sv, "1.7976931348623157e308"sv};
+    compareFloatConversions<float>("float", "short", shortNumbers);
+    compareFloatConversions<float>("float", "long", longNumbers);
+    compareFloatConversions<double>("double", "short", shortNumbers);
+    compareFloatConversions<double>("double", "long", longNumbers);
+}
@@ -0,0 +1,96 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Console IODevice used by tests, counts write calls and records data sent to it.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTS_COUNTINGIODEVICE_H_
+#define TESTS_COUNTINGIODEVICE_H_
+
+#include <algorithm>
+#include <string_view>
+#include "IODevice/IODevice.h"
+
+namespace microhal {
+
+/**
+ * @brief Fake console. Input is supplied with feed(), everything written is recorded and every write call is counted.
+ *        Uses static buffers only so it may be used by tests that check heap usage.
+ */
+class CountingIODevice : public IODevice {
+ public:
+    int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+    void close() noexcept final {}
+    int isOpen() const noexcept final { return true; }
+
+    ssize_t read(char *buffer, size_t length) noexcept final {
+        length = std::min(length, inputSize - inputPos);
+        std::copy_n(&input[inputPos], length, buffer);
+        inputPos += length;
+        ++readCalls;
+        return length;
+    }
+
+    ssize_t availableBytes() const noexcept final { return inputSize - inputPos; }
+
+    ssize_t write(const char *data, size_t length) noexcept final {
+        ++writeCalls;
+        bytesWritten += length;
+        const size_t bufferSpace = sizeof(output) - outputSize;
+        std::copy_n(data, std::min(length, bufferSpace), &output[outputSize]);
+        outputSize += std::min(length, bufferSpace);
+        return length;
+    }
+
+    void feed(std::string_view data) {
+        if (inputPos == inputSize) inputPos = inputSize = 0;
+        data = data.substr(0, sizeof(input) - inputSize);
+        std::copy_n(data.begin(), data.size(), &input[inputSize]);
+        inputSize += data.size();
+    }
+
+    void reset() {
+        writeCalls = 0;
+        readCalls = 0;
+        bytesWritten = 0;
+        outputSize = 0;
+    }
+
+    std::string_view text() const { return {output, outputSize}; }
+
+    size_t writeCalls = 0;
+    size_t readCalls = 0;
+    size_t bytesWritten = 0;
+
+ private:
+    char input[1024];
+    size_t inputPos = 0;
+    size_t inputSize = 0;
+    char output[4096];
+    size_t outputSize = 0;
+};
+
+}  // namespace microhal
+
+#endif /* TESTS_COUNTINGIODEVICE_H_ */
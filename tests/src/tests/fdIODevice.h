@@ -0,0 +1,95 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      IODevice over POSIX file descriptors, used by tests and benchmarks running on Linux.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTS_FDIODEVICE_H_
+#define TESTS_FDIODEVICE_H_
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <chrono>
+#include "IODevice/IODevice.h"
+
+namespace microhal {
+
+/**
+ * @brief Console device built on top of a pair of file descriptors (pipe, pty, ...). Reads never block.
+ */
+class FdIODevice : public IODevice {
+ public:
+    FdIODevice(int readFd, int writeFd) : readFd(readFd), writeFd(writeFd) { fcntl(readFd, F_SETFL, fcntl(readFd, F_GETFL) | O_NONBLOCK); }
+
+    int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+    void close() noexcept final {}
+    int isOpen() const noexcept final { return true; }
+
+    ssize_t read(char *buffer, size_t length) noexcept final {
+        const auto received = ::read(readFd, buffer, length);
+        if (received <= 0) return 0;
+        bytesRead += received;
+        return received;
+    }
+
+    ssize_t availableBytes() const noexcept final {
+        int available = 0;
+        if (ioctl(readFd, FIONREAD, &available) < 0) return 0;
+        return available;
+    }
+
+    ssize_t write(const char *data, size_t length) noexcept final {
+        size_t written = 0;
+        while (written < length) {
+            const auto result = ::write(writeFd, data + written, length - written);
+            if (result <= 0) break;
+            written += result;
+        }
+        ++writeCalls;
+        return written;
+    }
+
+    /**
+     * @brief Sleeps until read descriptor becomes readable or timeout expires.
+     */
+    bool waitForInput(std::chrono::milliseconds timeout) const {
+        pollfd fd{readFd, POLLIN, 0};
+        return poll(&fd, 1, timeout.count()) > 0;
+    }
+
+    int readDescriptor() const { return readFd; }
+
+    size_t writeCalls = 0;
+    size_t bytesRead = 0;
+
+ private:
+    int readFd;
+    int writeFd;
+};
+
+}  // namespace microhal
+
+#endif /* TESTS_FDIODEVICE_H_ */
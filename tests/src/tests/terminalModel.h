@@ -0,0 +1,144 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Minimal VT100 terminal model used by tests to check what user sees on the console.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTS_TERMINALMODEL_H_
+#define TESTS_TERMINALMODEL_H_
+
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
+namespace microhal {
+
+/**
+ * @brief Interprets console output the way a VT100 terminal would: printable chars, backspace, CR, LF and
+ *        ESC [ n A, ESC [ n B, ESC [ n C, ESC [ n D, ESC [ K, ESC [ J sequences. Keeps the last rows of the screen.
+ */
+class TerminalModel {
+ public:
+    static constexpr size_t rowsCount = 32;
+    static constexpr size_t columnsCount = 160;
+
+    TerminalModel() { std::fill_n(&screen[0][0], rowsCount * columnsCount, ' '); }
+
+    void process(std::string_view data) {
+        for (auto sign : data)
+            process(sign);
+    }
+
+    void process(char sign) {
+        if (escape) {
+            if (sequenceSize < sizeof(sequence)) sequence[sequenceSize++] = sign;
+            if (sequenceSize == 1 && sign != '[') escape = false;
+            if (sequenceSize > 1 && sign >= 0x40 && sign <= 0x7E) {
+                executeSequence();
+                escape = false;
+            }
+            return;
+        }
+        switch (sign) {
+            case '\x1b':
+                escape = true;
+                sequenceSize = 0;
+                break;
+            case '\b':
+                if (column) --column;
+                break;
+            case '\r':
+                column = 0;
+                break;
+            case '\n':
+                newLine();
+                break;
+            default:
+                if (column < columnsCount) screen[row][column++] = sign;
+        }
+    }
+
+    /**
+     * @return row with cursor, without trailing spaces placed after cursor
+     */
+    std::string_view line() const {
+        const auto text = rowText(row);
+        return {screen[row], std::max(text.size(), column)};
+    }
+    std::string_view rowText(size_t index) const {
+        std::string_view text(screen[index], columnsCount);
+        return text.substr(0, text.find_last_not_of(' ') + 1);
+    }
+    size_t cursor() const { return column; }
+
+    bool operator==(const TerminalModel &other) const {
+        return row == other.row && column == other.column && std::equal(&screen[0][0], &screen[0][0] + rowsCount * columnsCount, &other.screen[0][0]);
+    }
+
+ private:
+    void newLine() {
+        if (row + 1 < rowsCount) {
+            ++row;
+            return;
+        }
+        std::copy(&screen[1][0], &screen[0][0] + rowsCount * columnsCount, &screen[0][0]);
+        std::fill_n(&screen[row][0], columnsCount, ' ');
+    }
+
+    void executeSequence() {
+        size_t count = 1;
+        std::from_chars(&sequence[1], &sequence[sequenceSize - 1], count);
+        switch (sequence[sequenceSize - 1]) {
+            case 'A':
+                row -= std::min(row, count);
+                break;
+            case 'B':
+                row = std::min(row + count, rowsCount - 1);
+                break;
+            case 'C':
+                column = std::min(column + count, columnsCount);
+                break;
+            case 'D':
+                column -= std::min(column, count);
+                break;
+            case 'K':
+                std::fill(&screen[row][column], &screen[row][columnsCount], ' ');
+                break;
+            case 'J':
+                std::fill(&screen[row][column], &screen[0][0] + rowsCount * columnsCount, ' ');
+                break;
+        }
+    }
+
+    char screen[rowsCount][columnsCount];
+    size_t row = 0;
+    size_t column = 0;
+    bool escape = false;
+    char sequence[8];
+    size_t sequenceSize = 0;
+};
+
+}  // namespace microhal
+
+#endif /* TESTS_TERMINALMODEL_H_ */
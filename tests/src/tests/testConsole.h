@@ -0,0 +1,82 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Console session used by tests, feeds keys to CLI and records its response.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTS_TESTCONSOLE_H_
+#define TESTS_TESTCONSOLE_H_
+
+#include <string_view>
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "terminalModel.h"
+
+namespace microhal {
+
+/**
+ * @brief Fake console device with terminal model that interprets everything sent to it. Test console derives from it, so the
+ *        device exists before menu and CLI built on top of it:
+ *        @code
+ *        struct Console : TestConsole {
+ *            Console() : root(device, status), cli(device, root) { attach(cli); }
+ *            Item status{"status"};
+ *            MainMenu<1> root;
+ *            CLI<> cli;
+ *        };
+ *        @endcode
+ */
+class TestConsole {
+ public:
+    /**
+     * @brief Feeds keys to console and processes them with one readInput call.
+     * @return Text sent to console in response, terminal model is already updated with it.
+     */
+    std::string_view type(std::string_view keys) {
+        device.reset();
+        device.feed(keys);
+        session->readInput();
+        terminal.process(device.text());
+        return device.text();
+    }
+
+    CountingIODevice device;
+    TerminalModel terminal;
+
+ protected:
+    /**
+     * @brief Sets CLI that processes typed keys, terminal shows text it has already sent (ex. prompt).
+     */
+    void attach(CLIBase &cli) {
+        session = &cli;
+        terminal.process(device.text());
+    }
+
+ private:
+    CLIBase *session = nullptr;
+};
+
+}  // namespace microhal
+
+#endif /* TESTS_TESTCONSOLE_H_ */
@@ -0,0 +1,77 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief      Menu item used by tests, reports its execution on console.
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTS_TESTITEM_H_
+#define TESTS_TESTITEM_H_
+
+#include <cstdint>
+#include <string_view>
+#include "menuItem.h"
+
+namespace microhal {
+
+/**
+ * @brief What TestItem writes to console when executed.
+ */
+enum class ItemOutput : uint8_t {
+    Nothing,   ///< nothing is written
+    Name,      ///< "<name>"
+    Executed,  ///< "executed <name>"
+    Call,      ///< "<name>(<parameters>);", parentheses are skipped when there are no parameters
+};
+
+/**
+ * @brief Menu item shared by tests. Writes to console text configured by @p output and returns value passed to
+ *        constructor, so tests can check which command was run and with what parameters.
+ */
+template <ItemOutput output = ItemOutput::Nothing>
+class TestItem : public MenuItem {
+ public:
+    constexpr TestItem(std::string_view name, int value = 0) : MenuItem(name), value(value) {}
+
+    int execute([[maybe_unused]] std::string_view parameters, IODevice &port) final {
+        using namespace std::literals;
+        if constexpr (output == ItemOutput::Executed) port.write("executed "sv);
+        if constexpr (output != ItemOutput::Nothing) port.write(name);
+        if constexpr (output == ItemOutput::Call) {
+            if (parameters.size()) {
+                port.write("("sv);
+                port.write(parameters);
+                port.write(")"sv);
+            }
+            port.write(";"sv);
+        }
+        return value;
+    }
+
+ private:
+    int value;
+};
+
+}  // namespace microhal
+
+#endif /* TESTS_TESTITEM_H_ */
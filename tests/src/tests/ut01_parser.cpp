@@ -29,8 +29,10 @@
 
 #include "IODevice/ioDeviceNull/IODeviceNull.h"
 #include "parsers/argumentParser.h"
+#include "parsers/flagParser.h"
 #include "parsers/ipParser.h"
 #include "parsers/numericParser.h"
+#include "parsers/stringParser.h"
 
 using namespace microhal;
 using namespace cli;
@@ -88,3 +90,143 @@ TEST_CASE("Test Parser") {
     parser.showUsage(console);
     CHECK(console.text() == result);
 }
+
+TEST_CASE("Test Parser reports missing and unrecognized arguments") {
+    static constexpr const NumericParser<uint32_t> baud('b', "baudrate", "baud", Parameter::Flag::Required, "Baudrate", 10, 200000);
+    static constexpr const FlagParser verbose('v', "verbose", Parameter::Flag::Optional, "Print details.");
+    static constexpr const StringParser label(-1, "label", "text", Parameter::Flag::Optional, "Port label.", 1, 10);
+
+    ArgumentParser<baud, verbose, label> parser("USART", "USART configuration.");
+    Console console;
+    CHECK(parser.parse("-v --label \"debug\"", console) == Status::MissingArgument);
+    CHECK(console.text() == "\n\r\tMissing argument: [-b baud]"sv);
+
+    console.bufferPos = 0;
+    CHECK(parser.parse("-b 9600 -x", console) == Status::UnrecognizedParameter);
+    CHECK(console.text() == "\n\r\tUnrecognized parameter: -x"sv);
+
+    console.bufferPos = 0;
+    CHECK(parser.parse("-b 9600 9600", console) == Status::UnrecognizedParameter);
+    CHECK(console.text() == "\n\r\tUnrecognized parameter: 9600"sv);
+
+    CHECK(parser.parse("-b 5", console) == Status::MinViolation);
+
+    CHECK(parser.parse("--label \"debug\" -b 9600", console) == Status::Success);
+    CHECK(parser.get<{"baud"}>() == 9600);
+    CHECK(parser.get<{"text"}>() == "debug"sv);
+    CHECK(parser.isParsed<{"text"}>());
+    CHECK_FALSE(parser.isParsed<{"verbose"}>());
+    CHECK_FALSE(parser.get<{"verbose"}>());
+
+    // values of previous call are cleared
+    CHECK(parser.parse("-b 115200", console) == Status::Success);
+    CHECK_FALSE(parser.isParsed<{"text"}>());
+    CHECK(parser.get<{"text"}>().empty());
+}
+
+TEST_CASE("Test Parser gives the same result as runtime parser") {
+    static constexpr const NumericParser<uint32_t> baud('b', "baudrate", "baud", Parameter::Flag::Optional, "Baudrate", 10, 200000);
+    static constexpr const NumericParser<float> timeout('t', "timeout", "seconds", Parameter::Flag::Optional, "Timeout.", 0.0f, 10.0f);
+    ArgumentParser<baud, timeout> parser("USART", "USART configuration.");
+
+    NumericParser<uint32_t> runtimeBaud('b', "baudrate", "baud", "Baudrate", 10, 200000);
+    NumericParser<float> runtimeTimeout('t', "timeout", "seconds", "Timeout.", 0.0f, 10.0f);
+    RuntimeArgumentParser<2> runtimeParser("USART", "USART configuration.");
+    runtimeParser.addArgument(runtimeBaud);
+    runtimeParser.addArgument(runtimeTimeout);
+
+    IODeviceNull ioDevice;
+    for (auto parameters : {"-b 115200 -t 2.5"sv, "--timeout 1 --baudrate 300"sv, "-b 1"sv, "-t 11"sv, ""sv, "-q"sv}) {
+        const auto status = parser.parse(parameters, ioDevice);
+        CHECK(status == runtimeParser.parse(parameters, ioDevice));
+        if (status == Status::Success) {
+            CHECK(parser.get<{"baud"}>() == runtimeBaud.value());
+            CHECK(parser.get<{"seconds"}>() == runtimeTimeout.value());
+        }
+    }
+
+    Console console, runtimeConsole;
+    parser.showUsage(console);
+    runtimeParser.showUsage(runtimeConsole);
+    CHECK(console.text() == runtimeConsole.text());
+}
+
+TEST_CASE("Test tokenizer") {
+    using implementationDetail::Token;
+    Token token;
+
+    implementationDetail::Tokenizer tokenizer("  -b 9600  --label \"a -x b\" 5");
+    REQUIRE(tokenizer.next(token));
+    CHECK(token.kind == Token::Kind::Option);
+    CHECK(token.text == "-b"sv);
+    REQUIRE(tokenizer.next(token));
+    CHECK(token.kind == Token::Kind::Value);
+    CHECK(token.text == "9600"sv);
+    REQUIRE(tokenizer.next(token));
+    CHECK(token.kind == Token::Kind::Option);
+    CHECK(token.text == "--label"sv);
+    REQUIRE(tokenizer.next(token));
+    CHECK(token.kind == Token::Kind::Quoted);
+    CHECK(token.text == "\"a -x b\""sv);
+    REQUIRE(tokenizer.next(token));
+    CHECK(token.text == "5"sv);
+    CHECK_FALSE(tokenizer.next(token));
+
+    CHECK_FALSE(implementationDetail::Tokenizer("   ").next(token));
+    implementationDetail::Tokenizer unterminated("\"unterminated -x");
+    REQUIRE(unterminated.next(token));
+    CHECK(token.text == "\"unterminated -x"sv);
+    CHECK_FALSE(unterminated.next(token));
+
+    // taken tokens are joined with spaces between them, missing ones are skipped
+    implementationDetail::Tokenizer values(" 1  2 3   4 ");
+    CHECK(values.take(0).empty());
+    CHECK(values.take(2) == "1  2"sv);
+    CHECK(values.take(3) == "3   4"sv);
+    CHECK(values.take(1).empty());
+}
+
+TEST_CASE("Test Parser handles quoted values and long parameter lists") {
+    static constexpr const NumericParser<int32_t> offset('o', "offset", "offset", Parameter::Flag::Optional, "Offset", -100, 100);
+    static constexpr const StringParser label(-1, "label", "text", Parameter::Flag::Optional, "Port label.", 1, 20);
+    ArgumentParser<offset, label> parser("PORT", "Port configuration.");
+
+    Console console;
+    CHECK(parser.parse("--label \"-o 5 --label x\" -o -7", console) == Status::Success);
+    CHECK(parser.get<{"text"}>() == "-o 5 --label x"sv);
+    CHECK(parser.get<{"offset"}>() == -7);
+
+    // parameter of last option is missing
+    CHECK(parser.parse("--label", console) == Status::IncorectArgument);
+
+    // parameters count isn't limited
+    CHECK(parser.parse("-o 1 -o 2 -o 3 -o 4 -o 5 -o 6 -o 7 -o 8 -o 9 -o 10 -o 11 -o 12 --label x -o 13", console) == Status::Success);
+    CHECK(parser.get<{"offset"}>() == 13);
+    CHECK(console.text().empty());
+}
+
+TEST_CASE("Test Parser finds options in dispatch table") {
+    static constexpr const FlagParser alpha('a', "alpha", Parameter::Flag::Optional, "Alpha.");
+    static constexpr const FlagParser beta(-1, "beta", Parameter::Flag::Optional, "Beta.");
+    static constexpr const FlagParser gamma('g', "", Parameter::Flag::Optional, "Gamma.");
+    static constexpr const NumericParser<uint8_t> count('c', "count", "count", Parameter::Flag::Optional, "Count.", 0, 200);
+    static constexpr const FlagParser alphabet('A', "alphabet", Parameter::Flag::Optional, "Alphabet.");
+    ArgumentParser<alpha, beta, gamma, count, alphabet> parser("CMD", "Command.");
+
+    Console console;
+    CHECK(parser.parse("--alphabet --beta -g --count 7", console) == Status::Success);
+    CHECK(parser.isParsed<{"alphabet"}>());
+    CHECK(parser.isParsed<{"beta"}>());
+    CHECK_FALSE(parser.isParsed<{"alpha"}>());
+    CHECK(parser.get<{"count"}>() == 7);
+
+    CHECK(parser.parse("-A -a", console) == Status::Success);
+    CHECK(parser.isParsed<{"alpha"}>());
+    CHECK(parser.isParsed<{"alphabet"}>());
+
+    for (auto option : {"--alph"sv, "--alphabets"sv, "-b"sv, "--"sv, "-"sv, "--g"sv, "-\xff"sv}) {
+        console.bufferPos = 0;
+        CHECK(parser.parse(option, console) == Status::UnrecognizedParameter);
+        CHECK(console.text().ends_with(option));
+    }
+}
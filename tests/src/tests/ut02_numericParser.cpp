@@ -27,6 +27,14 @@
 
 #include <doctest/doctest.h>
 
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <limits>
+#include <random>
+#include "parsers/floatConversion.h"
 #include "parsers/numericParser.h"
 
 using namespace microhal;
@@ -134,3 +142,196 @@ TEST_CASE("Test float numeric Parser") {
         CHECK(numeric.parse("100.5") == Status::MaxViolation);
     }
 }
+
+TEST_CASE("Test Numeric Parser with prefixed base") {
+    NumericParser<uint16_t> numeric('r', "register", "value", "Register value", 0, 0x8000, NumericParser<uint16_t>::prefixedBase);
+    CHECK(numeric.parse("0x1F") == Status::Success);
+    CHECK(numeric.value() == 0x1F);
+    CHECK(numeric.parse("0Xabcd") == Status::MaxViolation);
+    CHECK(numeric.parse("0b1010") == Status::Success);
+    CHECK(numeric.value() == 0b1010);
+    CHECK(numeric.parse("0123") == Status::Success);
+    CHECK(numeric.value() == 123);
+    CHECK(numeric.parse("0") == Status::Success);
+    CHECK(numeric.value() == 0);
+    CHECK(numeric.parse("0x") == Status::IncorectArgument);
+    CHECK(numeric.parse("0b102") == Status::IncorectArgument);
+    CHECK(numeric.parse("0xG") == Status::IncorectArgument);
+
+    NumericParser<int32_t> offset('o', "offset", "value", "Offset", -0x100, 0x100, NumericParser<int32_t>::prefixedBase);
+    CHECK(offset.parse("-0x100") == Status::Success);
+    CHECK(offset.value() == -0x100);
+    CHECK(offset.parse("-0x101") == Status::MinViolation);
+    CHECK(offset.parse("0x101") == Status::MaxViolation);
+}
+
+TEST_CASE("Test Numeric Parser rejects text after number") {
+    NumericParser<uint32_t> numeric('n', "number", "varName", "Decode number", 0, 1000000000);
+    CHECK(numeric.parse("12abc") == Status::IncorectArgument);
+    CHECK(numeric.parse("123456789x") == Status::IncorectArgument);
+    CHECK(numeric.parse("12345678") == Status::Success);
+    CHECK(numeric.value() == 12345678);
+    CHECK(numeric.parse("1234567890") == Status::MaxViolation);
+    CHECK(numeric.parse("-1") == Status::IncorectArgument);
+    CHECK(numeric.parse("+1") == Status::IncorectArgument);
+}
+
+namespace {
+/**
+ * @brief Result that from_chars followed by range check would give.
+ */
+template <typename Type>
+std::pair<Type, Status> referenceConversion(std::string_view str, int base, Type min, Type max) {
+    Type value;
+    const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value, base);
+    if (error == std::errc::result_out_of_range) return {{}, str.starts_with('-') ? Status::MinViolation : Status::MaxViolation};
+    if (error != std::errc() || end != str.data() + str.size()) return {{}, Status::IncorectArgument};
+    if (value > max) return {{}, Status::MaxViolation};
+    if (value < min) return {{}, Status::MinViolation};
+    return {value, Status::Success};
+}
+
+template <typename Type>
+void compareWithFromChars(std::mt19937_64 &random) {
+    constexpr Type typeMin = std::numeric_limits<Type>::min();
+    constexpr Type typeMax = std::numeric_limits<Type>::max();
+    const Type min = std::is_signed_v<Type> ? typeMin / 2 : 3;
+    const Type max = typeMax / 3 * 2;
+    for (int base : {10, 16, 2, 8, 36}) {
+        for (int i = 0; i < 2000; i++) {
+            char text[80];
+            auto end = text;
+            if (std::is_signed_v<Type> && random() % 2) *end++ = '-';
+            // digits count around type width to hit range and overflow checks
+            const size_t digits = 1 + random() % (std::numeric_limits<Type>::digits + 4);
+            for (size_t d = 0; d < digits && end < std::end(text); d++) {
+                const auto digit = random() % base;
+                *end++ = "0123456789abcdefghijklmnopqrstuvwxyz"[digit];
+            }
+            // sometimes number is followed by character that isn't digit
+            if (random() % 16 == 0) *end++ = "z.x -"[random() % 5];
+            const std::string_view str(text, end);
+            const auto expected = referenceConversion<Type>(str, base, min, max);
+            const auto result = implementationDetail::toInteger<Type>(str, base, min, max);
+            if (expected.second != Status::Success && result.second != Status::Success && expected.second != result.second) {
+                // number out of range followed by non digit, conversion may stop on either of errors
+                CHECK((expected.second == Status::IncorectArgument || result.second == Status::IncorectArgument));
+                continue;
+            }
+            CHECK(result.second == expected.second);
+            CHECK(result.first == expected.first);
+        }
+    }
+}
+}  // namespace
+
+TEST_CASE("Test integer conversion gives the same results as from_chars") {
+    std::mt19937_64 random(2024);
+    compareWithFromChars<uint8_t>(random);
+    compareWithFromChars<int8_t>(random);
+    compareWithFromChars<uint16_t>(random);
+    compareWithFromChars<int16_t>(random);
+    compareWithFromChars<uint32_t>(random);
+    compareWithFromChars<int32_t>(random);
+    compareWithFromChars<uint64_t>(random);
+    compareWithFromChars<int64_t>(random);
+
+    for (auto [text, value] : {std::pair{"-9223372036854775808"sv, std::numeric_limits<int64_t>::min()},
+                               std::pair{"9223372036854775807"sv, std::numeric_limits<int64_t>::max()}}) {
+        const auto result = implementationDetail::toInteger<int64_t>(text, 10, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+        CHECK(result.second == Status::Success);
+        CHECK(result.first == value);
+    }
+    CHECK(implementationDetail::toInteger<int64_t>("-9223372036854775809", 10, std::numeric_limits<int64_t>::min(), 0).second == Status::MinViolation);
+    CHECK(implementationDetail::toInteger<uint64_t>("18446744073709551615", 10, 0, std::numeric_limits<uint64_t>::max()).first ==
+          std::numeric_limits<uint64_t>::max());
+    CHECK(implementationDetail::toInteger<uint64_t>("18446744073709551616", 10, 0, std::numeric_limits<uint64_t>::max()).second ==
+          Status::MaxViolation);
+}
+
+TEST_CASE("Test double numeric Parser keeps double precision") {
+    NumericParser<double> numeric('n', "number", "varName", "Decode number", -1e300, 1e300);
+    CHECK(numeric.parse("0.1") == Status::Success);
+    CHECK(numeric.value() == 0.1);
+    CHECK(numeric.parse("3.141592653589793") == Status::Success);
+    CHECK(numeric.value() == 3.141592653589793);
+    CHECK(numeric.parse("+1e300") == Status::Success);
+    CHECK(numeric.parse("1e301") == Status::MaxViolation);
+    CHECK(numeric.parse("-1e999") == Status::MinViolation);
+    CHECK(numeric.parse("inf") == Status::MaxViolation);
+    CHECK(numeric.parse("-Infinity") == Status::MinViolation);
+    CHECK(numeric.parse("nan") == Status::IncorectArgument);
+    CHECK(numeric.parse("1.5abc") == Status::IncorectArgument);
+    CHECK(numeric.parse("0x10") == Status::IncorectArgument);
+    CHECK(numeric.parse("1e") == Status::IncorectArgument);
+    CHECK(numeric.parse(".") == Status::IncorectArgument);
+    CHECK(numeric.parse("-.5") == Status::Success);
+    CHECK(numeric.value() == -0.5);
+    CHECK(numeric.parse("5.") == Status::Success);
+    CHECK(numeric.value() == 5.0);
+    // long input is no longer rejected
+    CHECK(numeric.parse("0.000000000000000000000000000000000000000012345678901234567890") == Status::Success);
+    CHECK(numeric.value() == 1.2345678901234567890e-41);
+}
+
+namespace {
+/**
+ * @brief Random decimal number with mantissa and exponent lengths that exercise both fast path and fallback.
+ */
+std::string randomDecimal(std::mt19937_64 &random) {
+    std::string number;
+    if (random() % 2) number += '-';
+    const size_t integerDigits = random() % 12;
+    const size_t fractionDigits = random() % 4 ? random() % 12 : random() % 30;
+    for (size_t i = 0; i < integerDigits; i++) number += static_cast<char>('0' + random() % 10);
+    if (fractionDigits || integerDigits == 0) {
+        number += '.';
+        for (size_t i = 0; i < std::max<size_t>(fractionDigits, 1); i++) number += static_cast<char>('0' + random() % 10);
+    }
+    if (random() % 2) {
+        number += random() % 2 ? 'e' : 'E';
+        number += std::to_string(static_cast<int>(random() % 700) - 350);
+    }
+    return number;
+}
+
+template <typename Type>
+std::pair<Type, Status> referenceFloatConversion(const std::string &number) {
+    char *end;
+    const Type value = std::is_same_v<Type, float> ? std::strtof(number.c_str(), &end) : std::strtod(number.c_str(), &end);
+    if (std::isinf(value)) return {{}, value > 0 ? Status::MaxViolation : Status::MinViolation};
+    return {value, Status::Success};
+}
+
+template <typename Type>
+void compareWithStrtod(std::mt19937_64 &random) {
+    constexpr Type max = std::numeric_limits<Type>::max();
+    for (int i = 0; i < 20000; i++) {
+        const auto number = randomDecimal(random);
+        const auto expected = referenceFloatConversion<Type>(number);
+        const auto result = implementationDetail::toFloatingPoint(number, -max, max);
+        CHECK(result.second == expected.second);
+        // the same bits, so sign of zero is compared too
+        CHECK(std::memcmp(&result.first, &expected.first, sizeof(Type)) == 0);
+    }
+}
+}  // namespace
+
+TEST_CASE("Test floating point conversion gives the same results as strtod") {
+    std::mt19937_64 random(2025);
+    compareWithStrtod<double>(random);
+    compareWithStrtod<float>(random);
+
+    // halfway cases and numbers near limits
+    for (std::string number : {"9007199254740993", "9007199254740992.5", "2.2250738585072011e-308", "4.9406564584124654e-324", "1.7976931348623157e308",
+                               "1.7976931348623159e308", "16777217", "3.4028235e38", "1.4e-45", "0.1", "123456789012345678901234567890"}) {
+        const auto expected = referenceFloatConversion<double>(number);
+        const auto result = implementationDetail::toFloatingPoint(number, -std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+        CHECK(result.second == expected.second);
+        CHECK(result.first == expected.first);
+        const auto expectedFloat = referenceFloatConversion<float>(number);
+        const auto resultFloat = implementationDetail::toFloatingPoint(number, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        CHECK(resultFloat.second == expectedFloat.second);
+        CHECK(resultFloat.first == expectedFloat.first);
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "outputBuffer.h"
+#include "parsers/argumentParser.h"
+#include "parsers/numericParser.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Executed>;
+}  // namespace
+
+TEST_CASE("Test Output Buffer") {
+    CountingIODevice console;
+    OutputBuffer<8> buffer(console);
+
+    buffer.write("abc"sv);
+    buffer.write("defgh"sv);
+    CHECK(console.writeCalls == 0);
+    CHECK(buffer.pending() == 8);
+
+    buffer.write("i"sv);
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "abcdefgh"sv);
+
+    // data bigger than buffer are passed through after pending data
+    buffer.write("0123456789"sv);
+    CHECK(console.writeCalls == 3);
+    CHECK(console.text() == "abcdefghi0123456789"sv);
+    CHECK(buffer.pending() == 0);
+
+    buffer.flush();
+    CHECK(console.writeCalls == 3);
+}
+
+TEST_CASE("Test CLI write calls") {
+    CountingIODevice console;
+    Item status("status"), set("set"), reboot("reboot");
+    SubMenu<2> clock("clock", status, set);
+    MainMenu<2> root(console, clock, reboot);
+    CLI cli(console, root, "hello");
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "hello\n\r> "sv);
+
+    // one write per keystroke
+    console.reset();
+    console.feed("c");
+    cli.readInput();
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "c"sv);
+
+    console.reset();
+    console.feed("\b");
+    cli.readInput();
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "\b \b"sv);
+
+    // one write per ls
+    console.feed("ls");
+    while (console.availableBytes()) cli.readInput();
+    console.reset();
+    console.feed("\r");
+    cli.readInput();
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "\n\r\tclock\n\r\treboot\n\r> "sv);
+
+    // one write per command
+    console.feed("reboot");
+    while (console.availableBytes()) cli.readInput();
+    console.reset();
+    console.feed("\r");
+    cli.readInput();
+    CHECK(console.writeCalls == 1);
+    CHECK(console.text() == "\n\rexecuted reboot\n\r> "sv);
+}
+
+TEST_CASE("Test ArgumentParser usage through output buffer") {
+    cli::NumericParser<int> seconds('s', {}, "seconds", "Seconds from 0 to 59.", 0, 59);
+    cli::RuntimeArgumentParser parser("set", "Set current time.");
+    parser.addArgument(seconds);
+
+    CountingIODevice console;
+    OutputBuffer<256> buffer(console);
+    parser.showUsage(buffer);
+    CHECK(console.writeCalls == 0);
+    buffer.flush();
+    CHECK(console.writeCalls == 1);
+}
@@ -0,0 +1,109 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "terminalModel.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Executed>;
+}  // namespace
+
+TEST_CASE("Test CLI drains whole input in one call") {
+    CountingIODevice console;
+    Item item("item");
+    MainMenu<1> root(console, item);
+    CLI cli(console, root);
+
+    constexpr auto pasted = "item\ritem\ritem\rsome text that is longer than single input chunk"sv;
+    console.feed(pasted);
+    console.reset();
+    cli.readInput();
+    CHECK(console.availableBytes() == 0);
+    // one write per prompt and one for the remaining echo
+    CHECK(console.writeCalls == 4);
+    CHECK(console.text() ==
+          "item\n\rexecuted item\n\r> "
+          "item\n\rexecuted item\n\r> "
+          "item\n\rexecuted item\n\r> "
+          "some text that is longer than single input chunk"sv);
+}
+
+TEST_CASE("Test CLI bulk input matches char by char input") {
+    constexpr auto alphabet = "abcitem [AB CD\r\n\t\b\x7f\x1b\x1b[\x01\x80"sv;
+    uint32_t seed = 1;
+    for (int iteration = 0; iteration < 200; iteration++) {
+        char input[400];
+        for (auto &sign : input) {
+            seed = seed * 1103515245 + 12345;
+            sign = alphabet[(seed >> 16) % alphabet.size()];
+        }
+
+        CountingIODevice bulkConsole;
+        Item bulkItem("item");
+        MainMenu<1> bulkRoot(bulkConsole, bulkItem);
+        CLI bulkCli(bulkConsole, bulkRoot);
+        bulkConsole.feed({input, sizeof(input)});
+        bulkCli.readInput();
+
+        CountingIODevice console;
+        Item item("item");
+        MainMenu<1> root(console, item);
+        CLI cli(console, root);
+        for (auto sign : input) {
+            console.feed({&sign, 1});
+            cli.readInput();
+        }
+        // insertions in the middle of line are redrawn once per run, so compare what user sees
+        TerminalModel bulkTerminal, terminal;
+        bulkTerminal.process(bulkConsole.text());
+        terminal.process(console.text());
+        CHECK(bulkTerminal == terminal);
+    }
+}
+
+TEST_CASE("Test CLI bulk input line overflow") {
+    CountingIODevice console;
+    Item item("item");
+    MainMenu<1> root(console, item);
+    CLI cli(console, root);
+    console.reset();
+    // line keeps at most 78 chars, rest is dropped
+    console.feed("0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"sv);
+    cli.readInput();
+    CHECK(console.text() == "012345678901234567890123456789012345678901234567890123456789012345678901234567"sv);
+    console.reset();
+    console.feed("\b\b9"sv);
+    cli.readInput();
+    CHECK(console.text() == "\b \b\b \b9"sv);
+}
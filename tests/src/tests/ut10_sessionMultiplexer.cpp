@@ -0,0 +1,127 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include "countingIODevice.h"
+#include "sessionMultiplexer.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Executed>;
+
+/**
+ * Writes tick three times, giving control back to console between writes.
+ */
+class Tick : public CoroutineMenuItem {
+ public:
+    Tick() : CoroutineMenuItem("tick") {}
+    CommandTask execute([[maybe_unused]] std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) final {
+        for (int i = 0; i < 3; i++) {
+            port.write("tick"sv);
+            co_await yield();
+        }
+        co_return 0;
+    }
+};
+}  // namespace
+
+TEST_CASE("Test independent sessions over shared menu tree") {
+    Item status("status"), reboot("reboot");
+    SubMenu<1> clock("clock", status);
+    SubMenu<2> tree("", clock, reboot);
+
+    CountingIODevice console1, console2;
+    MainMenuBase menu1(console1, tree), menu2(console2, tree);
+    CLI cli1(console1, menu1), cli2(console2, menu2);
+    SessionMultiplexer<4> sessions(cli1, cli2);
+    CHECK(sessions.size() == 2);
+
+    // escape sequence state is kept per session
+    console1.feed("\x1b["sv);
+    console2.feed("clock\r"sv);
+    CHECK(sessions.readInput() == 2);
+    console1.reset();
+    console2.reset();
+    console1.feed("B"sv);
+    console2.feed("B"sv);
+    CHECK(sessions.readInput() == 2);
+    // B was part of escape sequence in first session and ordinary char in second
+    CHECK(console1.text() == ""sv);
+    CHECK(console2.text() == "B"sv);
+    console2.reset();
+    console2.feed("\bstatus\r"sv);
+    CHECK(sessions.readInput() == 1);
+    CHECK(console2.text() == "\b \bstatus\n\rexecuted status\n\r> clock > "sv);
+
+    // position in menu tree is kept per session
+    console1.reset();
+    console1.feed("status\r"sv);
+    CHECK(sessions.readInput() == 1);
+    CHECK(console1.text() == "status\n\r\tno such command...\n\r> "sv);
+
+    sessions.remove(cli1);
+    CHECK(sessions.size() == 1);
+    CHECK(&sessions[0] == &cli2);
+    CHECK(sessions.add(cli1));
+    CHECK(sessions.size() == 2);
+}
+
+TEST_CASE("Test running command advances without input") {
+    Tick tick;
+    Item status("status");
+    SubMenu<2> tree("", tick, status);
+
+    CountingIODevice console1, console2;
+    MainMenuBase menu1(console1, tree), menu2(console2, tree);
+    CLI cli1(console1, menu1), cli2(console2, menu2);
+    SessionMultiplexer<2> sessions(cli1, cli2);
+
+    console1.reset();
+    console1.feed("tick\r"sv);
+    CHECK(sessions.readInput() == 1);
+    CHECK(cli1.commandRunning());
+    CHECK(console1.text() == "tick\n\rtick"sv);
+
+    // no key is pressed on any console, running command is still resumed
+    console1.reset();
+    CHECK(sessions.readInput() == 1);
+    CHECK(console1.text() == "tick"sv);
+    console1.reset();
+    CHECK(sessions.readInput() == 1);
+    CHECK(console1.text() == "tick"sv);
+    console1.reset();
+    CHECK(sessions.readInput() == 1);
+    CHECK_FALSE(cli1.commandRunning());
+    CHECK(console1.text() == "\n\r> "sv);
+
+    // idle sessions aren't served
+    CHECK(sessions.readInput() == 0);
+}
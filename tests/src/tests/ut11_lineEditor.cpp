@@ -0,0 +1,172 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <doctest/doctest.h>
+
+#include <string>
+#include "CLI.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+constexpr auto left = "\x1b[D"sv;
+constexpr auto right = "\x1b[C"sv;
+constexpr auto up = "\x1b[A"sv;
+constexpr auto down = "\x1b[B"sv;
+constexpr auto home = "\x1b[H"sv;
+constexpr auto end = "\x1b[F"sv;
+constexpr auto deleteKey = "\x1b[3~"sv;
+
+struct Console : TestConsole {
+    Console() : root(device, status, statistics, reboot), cli(device, root) { attach(cli); }
+
+    Item status{"status"}, statistics{"statistics"}, reboot{"reboot"};
+    MainMenu<3> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test line editor bytes on the wire") {
+    Console console;
+
+    CHECK(console.type("status --verbose"sv).size() == 16);
+    CHECK(console.terminal.line() == "> status --verbose"sv);
+
+    // cursor movement
+    CHECK(console.type(left).size() == 1);
+    CHECK(console.terminal.cursor() == 2 + 15);
+    CHECK(console.type(home).size() == 5);
+    CHECK(console.terminal.cursor() == 2);
+    CHECK(console.type(right).size() == 1);
+    CHECK(console.terminal.cursor() == 3);
+    CHECK(console.type(end).size() == 5);
+    CHECK(console.terminal.cursor() == 2 + 16);
+
+    // insert in the middle of the line sends changed suffix only
+    console.type(home);
+    for (int i = 0; i < 6; i++)
+        console.type(right);
+    CHECK(console.type("X"sv).size() == 11 + 5);
+    CHECK(console.terminal.line() == "> statusX --verbose"sv);
+    CHECK(console.terminal.cursor() == 2 + 7);
+
+    // backspace in the middle of the line
+    CHECK(console.type("\b"sv).size() == 1 + 10 + 1 + 5);
+    CHECK(console.terminal.line() == "> status --verbose"sv);
+    CHECK(console.terminal.cursor() == 2 + 6);
+
+    // delete
+    CHECK(console.type(deleteKey).size() == 9 + 1 + 5);
+    CHECK(console.terminal.line() == "> status--verbose"sv);
+    CHECK(console.terminal.cursor() == 2 + 6);
+
+    // backspace at the end of line
+    console.type(end);
+    CHECK(console.type("\b"sv).size() == 3);
+    CHECK(console.terminal.line() == "> status--verbos"sv);
+}
+
+TEST_CASE("Test line editor ignores control sequence with out of range parameter") {
+    Console console;
+    console.type("status"sv);
+    console.type(home);
+
+    // 259 and 2563 would wrap to 3 (delete) if the parameter was not saturated
+    CHECK(console.type("\x1b[259~"sv).size() == 0);
+    CHECK(console.type("\x1b[2563~"sv).size() == 0);
+    CHECK(console.terminal.line() == "> status"sv);
+    CHECK(console.terminal.cursor() == 2);
+
+    console.type(deleteKey);
+    CHECK(console.terminal.line() == "> tatus"sv);
+}
+
+TEST_CASE("Test line editor history navigation bytes on the wire") {
+    Console console;
+    console.type("statistics --all\r"sv);
+    console.type("status --verbose\r"sv);
+
+    CHECK(console.type(up).size() == 16);
+    CHECK(console.terminal.line() == "> status --verbose"sv);
+    // only part after common prefix "stat" is sent, whole line erase and reprint would take 3 * 16 + 16 bytes
+    CHECK(console.type(up).size() == 5 + 12);
+    CHECK(console.terminal.line() == "> statistics --all"sv);
+    CHECK(console.type(down).size() == 5 + 12);
+    CHECK(console.terminal.line() == "> status --verbose"sv);
+    // back to empty line
+    CHECK(console.type(down).size() == 5 + 3);
+    CHECK(console.terminal.line() == "> "sv);
+    CHECK(console.terminal.cursor() == 2);
+
+    // edit of command from history
+    console.type(up);
+    console.type(home);
+    console.type(deleteKey);
+    CHECK(console.terminal.line() == "> tatus --verbose"sv);
+    console.type("\r"sv);
+    CHECK(console.type(up).size() == 15);
+    CHECK(console.terminal.line() == "> tatus --verbose"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> status --verbose"sv);
+}
+
+TEST_CASE("Test line editor against reference model") {
+    Console console;
+    std::string line;
+    size_t cursor = 0;
+    constexpr std::string_view keys[] = {"a"sv, "b"sv, "cd"sv, "\b"sv, left, right, home, end, deleteKey};
+    uint32_t seed = 7;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245 + 12345;
+        const auto key = keys[(seed >> 16) % std::size(keys)];
+        if (key == "\b"sv) {
+            if (cursor) line.erase(--cursor, 1);
+        } else if (key == left) {
+            if (cursor) --cursor;
+        } else if (key == right) {
+            if (cursor < line.size()) ++cursor;
+        } else if (key == home) {
+            cursor = 0;
+        } else if (key == end) {
+            cursor = line.size();
+        } else if (key == deleteKey) {
+            if (cursor < line.size()) line.erase(cursor, 1);
+        } else {
+            const auto inserted = key.substr(0, 78 - line.size());
+            line.insert(cursor, inserted);
+            cursor += inserted.size();
+        }
+        console.type(key);
+        REQUIRE(console.terminal.line() == "> " + line);
+        REQUIRE(console.terminal.cursor() == 2 + cursor);
+    }
+}
@@ -0,0 +1,193 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <array>
+#include <deque>
+#include <random>
+#include <string>
+#include "CLI.h"
+#include "history.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+constexpr auto up = "\x1b[A"sv;
+constexpr auto down = "\x1b[B"sv;
+
+std::vector<std::string> newestFirst(const History &history) {
+    std::vector<std::string> entries;
+    if (history.empty()) return entries;
+    for (auto position = history.newest();; position = history.older(position)) {
+        entries.emplace_back(history[position]);
+        if (position == history.oldest()) break;
+    }
+    return entries;
+}
+
+std::vector<std::string> oldestFirst(const History &history) {
+    std::vector<std::string> entries;
+    if (history.empty()) return entries;
+    for (auto position = history.oldest();; position = history.newer(position)) {
+        entries.emplace_back(history[position]);
+        if (position == history.newest()) break;
+    }
+    return entries;
+}
+
+template <size_t historySize>
+struct Console : TestConsole {
+    Console() : root(device, status, statistics), cli(device, root) { attach(cli); }
+
+    Item status{"status"}, statistics{"statistics"};
+    MainMenu<2> root;
+    CLI<historySize> cli;
+};
+}  // namespace
+
+TEST_CASE("Test history stores entries with two bytes overhead") {
+    std::array<char, 800> arena;
+    History history(arena);
+
+    CHECK(history.empty());
+    CHECK_FALSE(history.push(""sv));
+    CHECK_FALSE(history.push(std::string(History::maxEntryLength + 1, 'x')));
+
+    // 800 bytes kept 10 commands of any length, now they are limited only by their size
+    const auto command = "memory dump -a 0x100"sv;
+    for (size_t i = 0; i < 100; i++) {
+        auto entry = std::string(command);
+        entry.back() = 'a' + i % 26;
+        history.push(entry);
+    }
+    CHECK(history.size() == arena.size() / (command.size() + 2));
+}
+
+TEST_CASE("Test history collapses consecutive duplicates") {
+    std::array<char, 64> arena;
+    History history(arena);
+
+    CHECK(history.push("status"sv));
+    CHECK(history.push("status"sv));
+    CHECK(history.push("reboot"sv));
+    CHECK(history.push("status"sv));
+    CHECK(history.push("status"sv));
+    CHECK(oldestFirst(history) == std::vector<std::string>{"status", "reboot", "status"});
+}
+
+TEST_CASE("Test history against reference model") {
+    std::mt19937 generator(1234);
+    for (size_t arenaSize : {16, 61, 100, 255, 257, 512}) {
+        std::vector<char> arena(arenaSize);
+        History history(arena);
+        std::deque<std::string> reference;
+
+        for (int step = 0; step < 5000; step++) {
+            const size_t length = std::uniform_int_distribution<size_t>(1, std::min<size_t>(arenaSize - 2, 40))(generator);
+            std::string entry(length, 'a' + generator() % 3);
+            REQUIRE(history.push(entry));
+            if (reference.empty() || reference.back() != entry) reference.push_back(entry);
+
+            // history keeps the newest entries, walked the same way in both directions
+            auto entries = oldestFirst(history);
+            REQUIRE(entries.size() == history.size());
+            REQUIRE(entries.size() <= reference.size());
+            REQUIRE(std::equal(entries.begin(), entries.end(), reference.end() - entries.size()));
+            auto reversed = newestFirst(history);
+            REQUIRE(std::equal(reversed.rbegin(), reversed.rend(), entries.begin(), entries.end()));
+
+            // space is lost only at arena end when entries wrap
+            size_t used = 0;
+            for (auto &stored : entries)
+                used += stored.size() + 2;
+            if (entries.size() < reference.size()) {
+                const auto &dropped = *(reference.end() - entries.size() - 1);
+                REQUIRE(used + dropped.size() + 2 + 40 + 2 > arenaSize);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test CLI history keeps up and down semantics") {
+    Console<HISTORYLENGTH> console;
+
+    // nothing to show
+    console.type(up);
+    CHECK(console.terminal.line() == "> "sv);
+
+    console.type("status\r"sv);
+    console.type("status\r"sv);
+    console.type("statistics\r"sv);
+
+    // line being typed is kept while history is browsed
+    console.type("sta"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> statistics"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> status"sv);
+    // duplicate was collapsed, oldest entry reached
+    console.type(up);
+    CHECK(console.terminal.line() == "> status"sv);
+    console.type(down);
+    CHECK(console.terminal.line() == "> statistics"sv);
+    console.type(down);
+    CHECK(console.terminal.line() == "> sta"sv);
+    console.type(down);
+    CHECK(console.terminal.line() == "> sta"sv);
+
+    // editing history entry replaces typed line and leaves history unchanged
+    console.type(up);
+    console.type("X"sv);
+    CHECK(console.terminal.line() == "> statisticsX"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> statistics"sv);
+    console.type(down);
+    CHECK(console.terminal.line() == "> statisticsX"sv);
+}
+
+TEST_CASE("Test CLI history arena size is independent of line length") {
+    // arena smaller than single line still allows to type long lines
+    Console<32> console;
+    const std::string longLine(70, 'x');
+
+    console.type(longLine + "\r");
+    console.type("status\r"sv);
+    console.type(longLine);
+    CHECK(console.terminal.line() == "> " + longLine);
+    console.type(up);
+    CHECK(console.terminal.line() == "> status"sv);
+    // long line didn't fit into history
+    console.type(up);
+    CHECK(console.terminal.line() == "> status"sv);
+    console.type(down);
+    CHECK(console.terminal.line() == "> " + longLine);
+}
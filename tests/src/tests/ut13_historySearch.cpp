@@ -0,0 +1,161 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+#include "CLI.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+constexpr auto ctrlR = "\x12"sv;
+constexpr auto ctrlG = "\x07"sv;
+constexpr auto up = "\x1b[A"sv;
+constexpr auto left = "\x1b[D"sv;
+
+struct Console : TestConsole {
+    Console() : root(device, status, statistics, reboot), cli(device, root) { attach(cli); }
+
+    Item status{"status"}, statistics{"statistics"}, reboot{"reboot"};
+    MainMenu<3> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test reverse search finds newest matching entry") {
+    Console console;
+    console.type("status\r"sv);
+    console.type("statistics --all\r"sv);
+    console.type("reboot\r"sv);
+    console.type("status --verbose\r"sv);
+
+    console.type("typed"sv);
+    console.type(ctrlR);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`': "sv);
+    console.type("st"sv);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`st': status --verbose"sv);
+
+    // match didn't change, only text from the search pattern end is sent
+    CHECK(console.type("a"sv).size() == 5 + 1 + 3 + 16);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`sta': status --verbose"sv);
+
+    // older match, only part after common prefix "stat" is sent
+    CHECK(console.type(ctrlR).size() == 5 + 12);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`sta': statistics --all"sv);
+    console.type(ctrlR);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`sta': status"sv);
+    // no older match
+    CHECK(console.type(ctrlR).size() == 0);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`sta': status"sv);
+
+    console.type("x"sv);
+    CHECK(console.terminal.line() == "> (failed reverse-i-search)`stax': status"sv);
+    // removed char brings back previous match
+    console.type("\b"sv);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`sta': status"sv);
+    console.type("\b\b\boo"sv);
+    CHECK(console.terminal.line() == "> (reverse-i-search)`oo': reboot"sv);
+
+    // Ctrl-G restores line typed before search
+    console.type(ctrlG);
+    CHECK(console.terminal.line() == "> typed"sv);
+    CHECK(console.terminal.cursor() == 2 + 5);
+}
+
+TEST_CASE("Test reverse search accepted entry") {
+    Console console;
+    console.type("status\r"sv);
+    console.type("reboot\r"sv);
+
+    // control key accepts found entry and is processed as usual
+    console.type(ctrlR);
+    console.type("sta"sv);
+    console.type(left);
+    CHECK(console.terminal.line() == "> status"sv);
+    CHECK(console.terminal.cursor() == 2 + 5);
+    console.type("X"sv);
+    CHECK(console.terminal.line() == "> statuXs"sv);
+
+    // enter executes found entry
+    console.type("\r"sv);
+    console.type(ctrlR);
+    console.type("boo\r"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> reboot"sv);
+    console.type(up);
+    CHECK(console.terminal.line() == "> statuXs"sv);
+}
+
+TEST_CASE("Test reverse search against brute force") {
+    std::mt19937 generator(42);
+    Console console;
+    std::vector<std::string> commands;
+    for (int i = 0; i < 30; i++) {
+        std::string command;
+        const size_t length = 1 + generator() % 12;
+        for (size_t j = 0; j < length; j++)
+            command += "abc"[generator() % 3];
+        if (commands.empty() || commands.back() != command) commands.push_back(command);
+        console.type(command + "\r");
+    }
+
+    for (int i = 0; i < 300; i++) {
+        std::string pattern;
+        const size_t length = 1 + generator() % 4;
+        for (size_t j = 0; j < length; j++)
+            pattern += "abc"[generator() % 3];
+        const size_t olderSearches = generator() % 3;
+
+        std::vector<std::string> matches;
+        for (auto command = commands.rbegin(); command != commands.rend(); command++) {
+            if (command->find(pattern) != std::string::npos) matches.push_back(*command);
+        }
+
+        console.type(ctrlR);
+        // type pattern char by char
+        for (char sign : pattern)
+            console.type({&sign, 1});
+        for (size_t j = 0; j < olderSearches; j++)
+            console.type(ctrlR);
+        const auto line = console.terminal.line();
+        if (matches.empty()) {
+            CHECK(line.find("(failed reverse-i-search)`" + pattern + "': ") == 2);
+        } else {
+            const auto &expected = matches[std::min(olderSearches, matches.size() - 1)];
+            CHECK(line == "> (reverse-i-search)`" + pattern + "': " + expected);
+        }
+        console.type(ctrlG);
+        REQUIRE(console.terminal.line() == "> "sv);
+    }
+}
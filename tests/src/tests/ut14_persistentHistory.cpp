@@ -0,0 +1,173 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "persistentHistory.h"
+#include "terminalModel.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+constexpr auto up = "\x1b[A"sv;
+constexpr size_t arenaSize = 256;
+
+/**
+ * @brief CLI session started on top of history file, like application started again.
+ */
+struct Session {
+    Session(const char *fileName, size_t arenaSize = ::arenaSize)
+        : historyFile(fileName, arenaSize), root(device, status, reboot), cli(device, root, historyFile.arena(), historyFile.state()) {
+        terminal.process(device.text());
+    }
+
+    void type(std::string_view keys) {
+        device.reset();
+        device.feed(keys);
+        cli.readInput();
+        terminal.process(device.text());
+    }
+
+    CountingIODevice device;
+    TerminalModel terminal;
+    PersistentHistory historyFile;
+    Item status{"status"}, reboot{"reboot"};
+    MainMenu<2> root;
+    CLI<std::dynamic_extent> cli;
+};
+
+struct TemporaryFile {
+    TemporaryFile() { close(mkstemp(name)); }
+    ~TemporaryFile() { unlink(name); }
+
+    void overwrite(off_t offset, std::string_view data) {
+        const int fd = open(name, O_WRONLY);
+        CHECK(pwrite(fd, data.data(), data.size(), offset) == static_cast<ssize_t>(data.size()));
+        close(fd);
+    }
+
+    char name[32] = "/tmp/cliHistoryXXXXXX";
+};
+
+void fillHistory(const char *fileName) {
+    Session session(fileName);
+    REQUIRE(session.historyFile.isOpen());
+    session.type("status --all\r"sv);
+    session.type("reboot now\r"sv);
+}
+
+/**
+ * @return history entries shown by up arrow, newest first.
+ */
+std::string recall(Session &session, size_t count) {
+    std::string lines;
+    for (size_t i = 0; i < count; i++) {
+        session.type(up);
+        lines += session.terminal.line();
+        lines += '|';
+    }
+    return lines;
+}
+}  // namespace
+
+TEST_CASE("Test persistent history survives restart") {
+    TemporaryFile file;
+    fillHistory(file.name);
+
+    {
+        Session session(file.name);
+        CHECK(recall(session, 3) == "> reboot now|> status --all|> status --all|");
+
+        // history keeps growing after restart and wraps around in the file
+        for (int i = 0; i < 100; i++)
+            session.type("status " + std::to_string(i) + "\r");
+    }
+    Session session(file.name);
+    CHECK(recall(session, 2) == "> status 99|> status 98|");
+}
+
+TEST_CASE("Test persistent history truncated file starts empty") {
+    TemporaryFile file;
+    fillHistory(file.name);
+    CHECK(truncate(file.name, 100) == 0);
+
+    Session session(file.name);
+    CHECK(recall(session, 1) == "> |");
+    session.type("status\r"sv);
+    CHECK(recall(session, 1) == "> status|");
+}
+
+TEST_CASE("Test persistent history corrupted file starts empty") {
+    TemporaryFile file;
+
+    // different arena size
+    fillHistory(file.name);
+    {
+        Session session(file.name, arenaSize * 2);
+        CHECK(recall(session, 1) == "> |");
+    }
+
+    // broken header
+    fillHistory(file.name);
+    file.overwrite(0, "X"sv);
+    {
+        Session session(file.name);
+        CHECK(recall(session, 1) == "> |");
+    }
+
+    // broken entry length, file header takes 24 bytes and first entry starts at the arena beginning
+    fillHistory(file.name);
+    {
+        Session session(file.name);
+        CHECK(recall(session, 1) == "> reboot now|");
+    }
+    file.overwrite(24, "\x05"sv);
+    {
+        Session session(file.name);
+        CHECK(recall(session, 1) == "> |");
+    }
+
+    // ring state pointing outside of arena
+    fillHistory(file.name);
+    file.overwrite(12, "\xff\xff"sv);
+    {
+        Session session(file.name);
+        CHECK(recall(session, 1) == "> |");
+    }
+}
+
+#endif  // defined(__linux__)
@@ -0,0 +1,179 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "scriptRunner.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Call>;
+
+struct Record {
+    size_t lineNumber;
+    std::string line;
+    MainMenuBase::Result::Status status;
+    int value;
+    bool operator==(const Record &) const = default;
+};
+
+class RecordingRunner : public ScriptRunner {
+ public:
+    using ScriptRunner::ScriptRunner;
+    std::vector<Record> records;
+
+ protected:
+    void lineProcessed(size_t lineNumber, std::string_view line, MainMenuBase::Result result) final {
+        records.push_back({lineNumber, std::string(line), result.status, result.value});
+    }
+};
+
+using Status = MainMenuBase::Result::Status;
+
+struct Menu {
+    Menu() : clock("clock", set), root(device, status, fail, clock) {}
+
+    CountingIODevice device;
+    Item status{"status"}, fail{"fail", 3}, set{"set"};
+    SubMenu<1> clock;
+    MainMenu<3> root;
+};
+}  // namespace
+
+TEST_CASE("Test script runner executes lines without echo and prompt") {
+    Menu menu;
+    RecordingRunner runner(menu.root);
+
+    const auto summary = runner.run("status\r\n# comment\n\nclock\nset -s 5\r..\rstatus -v"sv);
+    CHECK(menu.device.text() == "status;set(-s 5);status(-v);"sv);
+    CHECK(summary.lines == 7);
+    CHECK(summary.executed == 5);
+    CHECK(summary.failed == 0);
+    CHECK_FALSE(summary.stopped);
+    CHECK(runner.records == std::vector<Record>{{1, "status", Status::Executed, 0},
+                                                {4, "clock", Status::MenuChanged, 0},
+                                                {5, "set -s 5", Status::Executed, 0},
+                                                {6, "..", Status::MenuChanged, 0},
+                                                {7, "status -v", Status::Executed, 0}});
+}
+
+TEST_CASE("Test script runner stops on first error") {
+    Menu menu;
+    RecordingRunner runner(menu.root);
+
+    const auto summary = runner.run("status\nfail\nstatus\n"sv);
+    CHECK(menu.device.text() == "status;fail;"sv);
+    CHECK(summary.stopped);
+    CHECK(summary.lines == 2);
+    CHECK(summary.failed == 1);
+    CHECK(runner.records.back() == Record{2, "fail", Status::Executed, 3});
+
+    menu.device.reset();
+    const auto notFound = runner.run("status\nunknown\nstatus\n"sv);
+    CHECK(notFound.stopped);
+    CHECK(notFound.lines == 2);
+    // batch mode doesn't print errors
+    CHECK(menu.device.text() == "status;"sv);
+}
+
+TEST_CASE("Test script runner continues after error") {
+    Menu menu;
+    RecordingRunner runner(menu.root, ScriptRunner::OnError::Continue);
+
+    const auto summary = runner.run("fail\nunknown\nstatus\n"sv);
+    CHECK_FALSE(summary.stopped);
+    CHECK(summary.lines == 3);
+    CHECK(summary.executed == 3);
+    CHECK(summary.failed == 2);
+    CHECK(runner.records == std::vector<Record>{{1, "fail", Status::Executed, 3}, {2, "unknown", Status::NotFound, 0}, {3, "status", Status::Executed, 0}});
+}
+
+TEST_CASE("Test script runner reads stream") {
+    Menu menu;
+    CountingIODevice script;
+    RecordingRunner runner(menu.root, ScriptRunner::OnError::Continue);
+
+    const std::string longLine = "status " + std::string(SCRIPTLINELENGTH, 'x');
+    script.feed("status -a\r\n" + longLine + "\r\nstatus -b\nstatus -c");
+    const auto summary = runner.run(script);
+    CHECK(menu.device.text() == "status(-a);status(-b);status(-c);"sv);
+    CHECK(summary.lines == 4);
+    CHECK(summary.executed == 3);
+    CHECK(summary.failed == 1);
+    REQUIRE(runner.records.size() == 4);
+    CHECK(runner.records[1].lineNumber == 2);
+    CHECK(runner.records[1].status == Status::LineTooLong);
+    CHECK(runner.records[3] == Record{4, "status -c", Status::Executed, 0});
+}
+
+TEST_CASE("Test script runner stream split into small reads") {
+    /**
+     * Serves script in reads of at most readSize bytes.
+     */
+    class ChunkedDevice : public IODevice {
+     public:
+        ChunkedDevice(std::string_view text, size_t readSize) : text(text), readSize(readSize) {}
+
+        int open([[maybe_unused]] OpenMode mode) noexcept final { return true; }
+        void close() noexcept final {}
+        int isOpen() const noexcept final { return true; }
+        ssize_t read(char *buffer, size_t length) noexcept final {
+            length = std::min({length, readSize, text.size()});
+            text.copy(buffer, length);
+            text.remove_prefix(length);
+            return length;
+        }
+        ssize_t availableBytes() const noexcept final { return text.size(); }
+        ssize_t write([[maybe_unused]] const char *data, size_t length) noexcept final { return length; }
+
+     private:
+        std::string_view text;
+        size_t readSize;
+    };
+
+    const auto script = "status -a\r\n\r\nclock\rset\n\n..\r\r\nfail\r\nstatus -b\r"sv;
+    Menu reference;
+    RecordingRunner referenceRunner(reference.root, ScriptRunner::OnError::Continue);
+    const auto expected = referenceRunner.run(script);
+
+    for (size_t readSize : {1, 2, 3, 5, 8}) {
+        Menu menu;
+        ChunkedDevice device(script, readSize);
+        RecordingRunner runner(menu.root, ScriptRunner::OnError::Continue);
+        const auto summary = runner.run(device);
+        CHECK(summary.lines == expected.lines);
+        CHECK(summary.executed == expected.executed);
+        CHECK(runner.records == referenceRunner.records);
+        CHECK(menu.device.text() == reference.device.text());
+    }
+}
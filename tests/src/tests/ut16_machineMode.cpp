@@ -0,0 +1,174 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <charconv>
+#include <string>
+#include <vector>
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Call>;
+
+struct Frame {
+    std::string id;
+    int status;
+    int value;
+    std::string payload;
+    bool operator==(const Frame &) const = default;
+};
+
+/**
+ * @brief Parses "<id> <status> <value> <length>\n<payload>" frames, like host would do.
+ */
+std::vector<Frame> parseFrames(std::string_view text) {
+    std::vector<Frame> frames;
+    while (text.size()) {
+        const auto headerEnd = text.find('\n');
+        REQUIRE(headerEnd != text.npos);
+        const auto header = text.substr(0, headerEnd);
+        const auto idEnd = header.find(' ');
+        const auto statusEnd = header.find(' ', idEnd + 1);
+        const auto valueEnd = header.find(' ', statusEnd + 1);
+        REQUIRE(valueEnd != header.npos);
+        Frame frame{std::string(header.substr(0, idEnd)), 0, 0, {}};
+        size_t length = 0;
+        std::from_chars(&header[idEnd + 1], &header[statusEnd], frame.status);
+        std::from_chars(&header[statusEnd + 1], &header[valueEnd], frame.value);
+        std::from_chars(&header[valueEnd + 1], header.data() + header.size(), length);
+        text.remove_prefix(headerEnd + 1);
+        REQUIRE(length <= text.size());
+        frame.payload = text.substr(0, length);
+        text.remove_prefix(length);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+struct Console : TestConsole {
+    Console() : clock("clock", set), root(device, status, fail, clock, error, partial), cli(device, root) {
+        attach(cli);
+        cli.setMachineMode(true);
+        device.reset();
+    }
+
+    std::vector<Frame> request(std::string_view requests) { return parseFrames(type(requests)); }
+
+    Item status{"status"}, fail{"fail", 3}, set{"set"}, error{"error", -1}, partial{"partial", -3};
+    SubMenu<1> clock;
+    MainMenu<5> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test machine mode pipelined requests") {
+    Console console;
+
+    const auto frames = console.request("1 status\n2 unknown\n3 fail -x\n4\n"sv);
+    CHECK(frames == std::vector<Frame>{{"1", FrameWriterBase::Executed, 0, "status;"},
+                                         {"2", FrameWriterBase::NotFound, 0, ""},
+                                         {"3", FrameWriterBase::Executed, 3, "fail(-x);"},
+                                         {"4", FrameWriterBase::Executed, 0, ""}});
+    // responses to all pipelined requests are sent at once
+    CHECK(console.device.writeCalls == 1);
+}
+
+TEST_CASE("Test machine mode requests split between reads") {
+    Console console;
+
+    CHECK(console.request("a1 sta"sv).empty());
+    CHECK(console.request("tus -v\r"sv).empty() == false);
+    CHECK(console.request("\na2 clock\r\na3 set -s 1\r"sv) == std::vector<Frame>{{"a2", FrameWriterBase::Executed, 0, ""}, {"a3", FrameWriterBase::Executed, 0, "set(-s 1);"}});
+    // no echo and no line editing, control chars are passed as they are
+    CHECK(console.request("a4 status \x1b[D\b\n"sv) == std::vector<Frame>{{"a4", FrameWriterBase::NotFound, 0, ""}});
+}
+
+TEST_CASE("Test machine mode long output and request") {
+    class Dump : public MenuItem {
+     public:
+        Dump() : MenuItem("dump") {}
+        int execute([[maybe_unused]] std::string_view parameters, IODevice &port) final {
+            port.write(std::string(150, 'x'));
+            return 0;
+        }
+    } dump;
+    CountingIODevice device;
+    MainMenu<1> root(device, dump);
+    CLI<> cli(device, root);
+    cli.setMachineMode(true);
+    device.reset();
+
+    device.feed("7 dump\n"sv);
+    cli.readInput();
+    const auto frames = parseFrames(device.text());
+    REQUIRE(frames.size() == 3);
+    CHECK(frames[0] == Frame{"7", FrameWriterBase::Partial, 0, std::string(FRAMELENGTH, 'x')});
+    CHECK(frames[1] == Frame{"7", FrameWriterBase::Partial, 0, std::string(FRAMELENGTH, 'x')});
+    CHECK(frames[2] == Frame{"7", FrameWriterBase::Executed, 0, std::string(150 - 2 * FRAMELENGTH, 'x')});
+
+    device.reset();
+    device.feed("8 dump " + std::string(LINELENGTH, 'y') + "\n9 dump\n");
+    cli.readInput();
+    const auto tooLong = parseFrames(device.text());
+    REQUIRE(tooLong.size() == 4);
+    CHECK(tooLong[0] == Frame{"8", FrameWriterBase::LineTooLong, 0, ""});
+    CHECK(tooLong[3].id == "9");
+}
+
+TEST_CASE("Test machine mode switch") {
+    Console console;
+
+    console.request("1 clock\n"sv);
+    console.device.reset();
+    console.cli.setMachineMode(false);
+    CHECK(console.device.text() == "\n\r> clock > "sv);
+
+    // human console works as before
+    console.device.reset();
+    console.device.feed("set\r"sv);
+    console.cli.readInput();
+    CHECK(console.device.text() == "set\n\rset;\n\r> clock > "sv);
+
+    console.cli.setMachineMode(true);
+    CHECK(console.cli.isMachineMode());
+    CHECK(console.request("2 ..\n3 status\n"sv) == std::vector<Frame>{{"2", FrameWriterBase::Executed, 0, ""}, {"3", FrameWriterBase::Executed, 0, "status;"}});
+}
+
+TEST_CASE("Test machine mode negative command values") {
+    Console console;
+
+    // values that were used by protocol statuses can't be confused with them
+    CHECK(console.request("1 error\n2 partial\n3 unknown\n"sv) == std::vector<Frame>{{"1", FrameWriterBase::Executed, -1, "error;"},
+                                                                                    {"2", FrameWriterBase::Executed, -3, "partial;"},
+                                                                                    {"3", FrameWriterBase::NotFound, 0, ""}});
+}
@@ -0,0 +1,88 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Call>;
+
+CountingIODevice device;
+
+constinit Item status("status");
+constinit Item set("set");
+constinit Item on("on");
+constexpr SubMenu<1> alarm("alarm", on);
+constexpr SubMenu<2> clockMenu("clock", set, alarm);
+constexpr SubMenu<1> empty("empty");
+constexpr SubMenu<3> tree("", status, clockMenu, empty);
+constinit MainMenuBase menu(device, tree);
+
+static_assert(MenuEntry(clockMenu).name() == "clock"sv);
+static_assert(MenuEntry(clockMenu).isSubMenu());
+static_assert(!MenuEntry(status).isSubMenu());
+static_assert(MenuEntry(alarm).subMenu().name == "alarm"sv);
+
+using Status = MainMenuBase::Result::Status;
+}  // namespace
+
+TEST_CASE("Test constinit menu tree executes commands and navigates") {
+    device.reset();
+    CHECK(menu.processCommand("status -v"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(menu.processCommand("clock"sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+    CHECK(menu.processCommand("set 5"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(menu.processCommand("status"sv, MainMenuBase::Mode::Batch).status == Status::NotFound);
+    CHECK(menu.processCommand("alarm"sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+    CHECK(menu.processCommand("on"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(menu.processCommand(".."sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+    CHECK(menu.processCommand("set"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(menu.processCommand("exit"sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+    CHECK(menu.processCommand("status"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(device.text() == "status(-v);set(5);on;set;status;"sv);
+}
+
+TEST_CASE("Test constinit menu tree with empty sub menu") {
+    device.reset();
+    CHECK(menu.processCommand("empty"sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+    CHECK(menu.processCommand("anything"sv, MainMenuBase::Mode::Batch).status == Status::NotFound);
+    CHECK(menu.processCommand("ls"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(device.text().empty());
+    CHECK(menu.processCommand("exit"sv, MainMenuBase::Mode::Batch).status == Status::MenuChanged);
+}
+
+TEST_CASE("Test constinit menu tree completion without index") {
+    CHECK(clockMenu.complete("s"sv).matches == 1);
+    CHECK(clockMenu.complete("s"sv).common == "set"sv);
+    CHECK(tree.complete(""sv).matches == 3);
+    CHECK(tree.complete("e"sv).common == "empty"sv);
+    CHECK(tree.complete("x"sv).matches == 0);
+}
@@ -0,0 +1,104 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Call>;
+
+using Status = MainMenuBase::Result::Status;
+}  // namespace
+
+TEST_CASE("Test sub menu lookup finds items in any declaration order") {
+    Item zeta("zeta"), alpha("alpha"), mid("mid"), alpha2("alpha", 2);
+    SubMenu<1> sub("beta");
+    SubMenu<6> menu("", zeta, alpha, sub, mid, alpha2);
+
+    CHECK(menu.find("zeta"sv)->name() == "zeta"sv);
+    CHECK(menu.find("beta"sv)->isSubMenu());
+    CHECK(&menu.find("mid"sv)->command() == &mid);
+    // first declared item wins, like in linear search
+    CHECK(&menu.find("alpha"sv)->command() == &alpha);
+    CHECK(menu.find("alph"sv) == nullptr);
+    CHECK(menu.find("alphaa"sv) == nullptr);
+    CHECK(menu.find("a"sv) == nullptr);
+    CHECK(menu.find("zz"sv) == nullptr);
+    CHECK(menu.find(""sv) == nullptr);
+
+    SubMenu<1> empty("empty");
+    CHECK(empty.find("empty"sv) == nullptr);
+}
+
+TEST_CASE("Test dynamic sub menu keeps index sorted when items are added") {
+    Item c("c"), a("a"), b("b"), a2("a", 2);
+    SubMenu<std::dynamic_extent> menu("", c);
+    menu.addItem(a);
+    menu.addItem(b);
+    menu.addItem(a2);
+
+    CHECK(&menu.find("a"sv)->command() == &a);
+    CHECK(&menu.find("b"sv)->command() == &b);
+    CHECK(&menu.find("c"sv)->command() == &c);
+    CHECK(menu.find("d"sv) == nullptr);
+}
+
+TEST_CASE("Test indexed lookup keeps listing in declaration order") {
+    CountingIODevice device;
+    Item zeta("zeta"), alpha("alpha", 4);
+    MainMenu<2> root(device, zeta, alpha);
+
+    CHECK(root.processCommand("ls"sv, MainMenuBase::Mode::Batch).status == Status::Executed);
+    CHECK(device.text() == "\n\r\tzeta\n\r\talpha"sv);
+    device.reset();
+    const auto result = root.processCommand("alpha"sv, MainMenuBase::Mode::Batch);
+    CHECK(result.status == Status::Executed);
+    CHECK(result.value == 4);
+    CHECK(device.text() == "alpha;"sv);
+}
+
+TEST_CASE("Test sub menu completion finds matching range") {
+    Item statistics("statistics"), status("status"), reboot("reboot");
+    SubMenu<3> menu("", statistics, status, reboot);
+
+    auto completion = menu.complete("st"sv);
+    CHECK(completion.matches == 2);
+    CHECK(completion.common == "stat"sv);
+    completion = menu.complete("statu"sv);
+    CHECK(completion.matches == 1);
+    CHECK(completion.common == "status"sv);
+    completion = menu.complete(""sv);
+    CHECK(completion.matches == 3);
+    CHECK(completion.common == ""sv);
+    CHECK(menu.complete("x"sv).matches == 0);
+    CHECK(menu.complete("statuses"sv).matches == 0);
+}
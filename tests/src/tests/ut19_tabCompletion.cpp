@@ -0,0 +1,109 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include "CLI.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+struct Console : TestConsole {
+    Console() : root(device, status, statistics, reboot, clock), cli(device, root) { attach(cli); }
+
+    Item status{"status"}, statistics{"statistics"}, reboot{"reboot"}, set{"set"}, alarm{"alarm"};
+    SubMenu<2> clock{"clock", set, alarm};
+    MainMenu<4> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test tab completes unique command") {
+    Console console;
+    console.type("reb"sv);
+    CHECK(console.type("\t"sv).size() == 3);
+    CHECK(console.terminal.line() == "> reboot"sv);
+    // nothing more to complete, nothing is sent
+    CHECK(console.type("\t"sv).size() == 0);
+    CHECK(console.type("\t"sv).size() == 0);
+    CHECK(console.terminal.line() == "> reboot"sv);
+}
+
+TEST_CASE("Test tab fills longest common prefix and shows candidates on second tab") {
+    Console console;
+    console.type("s"sv);
+    CHECK(console.type("\t"sv).size() == 3);
+    CHECK(console.terminal.line() == "> stat"sv);
+    console.type("\t"sv);
+    CHECK(console.device.text() == "\n\r\tstatistics\n\r\tstatus\n\r> stat"sv);
+    CHECK(console.terminal.line() == "> stat"sv);
+
+    console.type("u\t"sv);
+    CHECK(console.terminal.line() == "> status"sv);
+}
+
+TEST_CASE("Test tab shows candidates only after second tab in a row") {
+    Console console;
+    console.type("stat"sv);
+    CHECK(console.type("\t"sv).size() == 0);
+    // typing in between cancels pending listing
+    console.type("i\b"sv);
+    CHECK(console.type("\t"sv).size() == 0);
+    CHECK(console.type("\t"sv).size() > 0);
+    CHECK(console.terminal.line() == "> stat"sv);
+}
+
+TEST_CASE("Test tab on empty line lists all commands in name order") {
+    Console console;
+    CHECK(console.type("\t"sv).size() == 0);
+    console.device.reset();
+    console.device.feed("\t"sv);
+    console.cli.readInput();
+    CHECK(console.device.text() == "\n\r\tclock\n\r\treboot\n\r\tstatistics\n\r\tstatus\n\r> "sv);
+}
+
+TEST_CASE("Test tab doesn't complete unknown command nor parameters") {
+    Console console;
+    console.type("x"sv);
+    CHECK(console.type("\t\t"sv).size() == 0);
+    console.type("\bstatus st"sv);
+    CHECK(console.type("\t\t"sv).size() == 0);
+    CHECK(console.terminal.line() == "> status st"sv);
+}
+
+TEST_CASE("Test tab completes in active sub menu") {
+    Console console;
+    console.type("cl\t"sv);
+    CHECK(console.terminal.line() == "> clock"sv);
+    console.type("\r"sv);
+    console.type("a\t"sv);
+    CHECK(console.terminal.line() == "> clock > alarm"sv);
+}
@@ -0,0 +1,148 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Call>;
+
+using Status = MainMenuBase::Result::Status;
+constexpr auto batch = MainMenuBase::Mode::Batch;
+
+struct Menu {
+    Menu() : alarm("alarm", on, off), clock("clock", set, alarm), root(device, status, clock, set) {}
+
+    Status run(std::string_view line) { return root.processCommand(line, batch).status; }
+
+    CountingIODevice device;
+    Item status{"status"}, set{"set"}, on{"on"}, off{"off"};
+    SubMenu<2> alarm;
+    SubMenu<2> clock;
+    MainMenu<3> root;
+};
+}  // namespace
+
+TEST_CASE("Test full path executes command without changing active menu") {
+    Menu menu;
+    CHECK(menu.run("clock alarm on"sv) == Status::Executed);
+    CHECK(menu.run("/clock/set -s 5"sv) == Status::Executed);
+    CHECK(menu.run("clock/alarm off now"sv) == Status::Executed);
+    CHECK(menu.run("clock set"sv) == Status::Executed);
+    // still in root folder
+    CHECK(menu.run("set -m 1"sv) == Status::Executed);
+    CHECK(menu.device.text() == "on;set(-s 5);off(now);set;set(-m 1);"sv);
+}
+
+TEST_CASE("Test path resolved from active menu or from root") {
+    Menu menu;
+    CHECK(menu.run("clock"sv) == Status::MenuChanged);
+    CHECK(menu.run("alarm on"sv) == Status::Executed);
+    CHECK(menu.run("clock alarm on"sv) == Status::NotFound);
+    CHECK(menu.run("/clock/alarm/on"sv) == Status::Executed);
+    CHECK(menu.run("/status x"sv) == Status::Executed);
+    // command from active menu, not root one
+    CHECK(menu.run("set"sv) == Status::Executed);
+    CHECK(menu.run("/set"sv) == Status::Executed);
+    CHECK(menu.device.text() == "on;on;status(x);set;set;"sv);
+}
+
+TEST_CASE("Test path ending at sub menu changes active menu") {
+    Menu menu;
+    CHECK(menu.run("clock alarm"sv) == Status::MenuChanged);
+    CHECK(menu.run("on"sv) == Status::Executed);
+    CHECK(menu.run(".."sv) == Status::MenuChanged);
+    CHECK(menu.run("set"sv) == Status::Executed);
+    CHECK(menu.run("/clock/alarm/"sv) == Status::MenuChanged);
+    CHECK(menu.run("off"sv) == Status::Executed);
+    CHECK(menu.run("/"sv) == Status::NotFound);
+    CHECK(menu.device.text() == "on;set;off;"sv);
+}
+
+TEST_CASE("Test invalid paths are not found") {
+    Menu menu;
+    CHECK(menu.run("clock alarm xyz"sv) == Status::NotFound);
+    CHECK(menu.run("clock/set/x"sv) == Status::NotFound);
+    CHECK(menu.run("clock  set"sv) == Status::NotFound);
+    CHECK(menu.run("status/x"sv) == Status::NotFound);
+    CHECK(menu.run("clock settings"sv) == Status::NotFound);
+    CHECK(menu.device.text().empty());
+}
+
+TEST_CASE("Test sub-folder deeper than MENUDEPTH is not entered") {
+    static_assert(MENUDEPTH == 8, "Test builds tree one level deeper than MENUDEPTH.");
+    CountingIODevice device;
+    Item command("command");
+    SubMenu<1> i("i", command);
+    SubMenu<1> h("h", i);
+    SubMenu<1> g("g", h);
+    SubMenu<1> f("f", g);
+    SubMenu<1> e("e", f);
+    SubMenu<1> d("d", e);
+    SubMenu<1> c("c", d);
+    SubMenu<1> b("b", c);
+    MainMenu<1> root(device, b);
+
+    // root folder and seven nested ones fill active position
+    CHECK(root.processCommand("b c d e f g h"sv, batch).status == Status::MenuChanged);
+    CHECK(root.processCommand("i"sv, batch).status == Status::NotFound);
+    CHECK(root.processCommand("i command"sv, batch).status == Status::Executed);
+    CHECK(root.processCommand("/b/c/d/e/f/g/h/i"sv, batch).status == Status::NotFound);
+    CHECK(root.processCommand("/b/c/d/e/f/g/h/i/command"sv).status == Status::Executed);
+    CHECK(root.processCommand("i"sv).status == Status::NotFound);
+    CHECK(device.text() == "command;\n\rcommand;\n\r\tsub-folder too deep..."sv);
+    // still in the deepest sub-folder that fits
+    CHECK(root.processCommand("i command"sv, batch).status == Status::Executed);
+}
+
+TEST_CASE("Test cached paths") {
+    Menu menu;
+    for (int i = 0; i < 3; i++) {
+        CHECK(menu.run("clock alarm on"sv) == Status::Executed);
+        CHECK(menu.run("clock alarm off 1"sv) == Status::Executed);
+        CHECK(menu.run("/clock/set"sv) == Status::Executed);
+        CHECK(menu.run("clock set 2"sv) == Status::Executed);
+        CHECK(menu.run("clock/alarm/on"sv) == Status::Executed);
+        // prefix of cached path
+        CHECK(menu.run("clock alarm o"sv) == Status::NotFound);
+        CHECK(menu.run("clock alarm onx"sv) == Status::NotFound);
+    }
+    CHECK(menu.device.text() == "on;off(1);set;set(2);on;on;off(1);set;set(2);on;on;off(1);set;set(2);on;"sv);
+
+    // relative paths cached in root folder aren't valid in other folder, absolute are
+    menu.device.reset();
+    CHECK(menu.run("clock"sv) == Status::MenuChanged);
+    CHECK(menu.run("clock alarm on"sv) == Status::NotFound);
+    CHECK(menu.run("/clock/set"sv) == Status::Executed);
+    CHECK(menu.run("alarm on"sv) == Status::Executed);
+    CHECK(menu.device.text() == "set;on;"sv);
+}
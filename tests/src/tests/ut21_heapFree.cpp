@@ -0,0 +1,151 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <cstdlib>
+#include <new>
+#include "CLI.h"
+#include "parsers/argumentParser.h"
+#include "parsers/numericParser.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+size_t allocations = 0;
+}  // namespace
+
+// Global allocation functions are replaced for whole test binary, they just count calls.
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+void operator delete(void *memory, [[maybe_unused]] std::size_t size) noexcept {
+    std::free(memory);
+}
+void operator delete[](void *memory, [[maybe_unused]] std::size_t size) noexcept {
+    std::free(memory);
+}
+
+namespace {
+using Item = TestItem<ItemOutput::Name>;
+
+/**
+ * Command that parses its parameters with runtime argument parser.
+ */
+class ClockSet : public MenuItem {
+ public:
+    ClockSet() : MenuItem("set") {
+        parser.addArgument(seconds);
+        parser.addArgument(minutes);
+    }
+
+    int execute(std::string_view parameters, IODevice &port) final {
+        const auto status = parser.parse(parameters, port);
+        if (status == cli::Status::Success) lastSeconds = seconds.value();
+        return static_cast<int>(status);
+    }
+
+    int lastSeconds = -1;
+
+ private:
+    cli::NumericParser<int> seconds{'s', {}, "seconds", "Seconds from 0 to 59.", 0, 59};
+    cli::NumericParser<int> minutes{'m', "minutes", "minutes", "Minutes from 0 to 59.", 0, 59};
+    cli::RuntimeArgumentParser<2> parser{"set", "Set current time."};
+};
+
+struct Console : TestConsole {
+    Console() : clock("clock", set), root(device, status, statistics, clock), cli(device, root) {
+        attach(cli);
+        clock.addItem(alarm);
+        clock.addItem(reboot);
+    }
+
+    Item status{"status"}, statistics{"statistics"}, alarm{"alarm"}, reboot{"reboot"};
+    ClockSet set;
+    SubMenu<4> clock;
+    MainMenu<3> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test fixed size sub menu accepts items up to its size") {
+    Item a("a"), b("b"), c("c");
+    SubMenu<2> menu("", b);
+    CHECK(menu.addItem(a));
+    CHECK_FALSE(menu.addItem(c));
+    CHECK(&menu.find("a"sv)->command() == &a);
+    CHECK(&menu.find("b"sv)->command() == &b);
+    CHECK(menu.find("c"sv) == nullptr);
+}
+
+TEST_CASE("Test runtime argument parser accepts arguments up to its capacity") {
+    cli::NumericParser<int> seconds('s', {}, "seconds", "Seconds from 0 to 59.", 0, 59);
+    cli::NumericParser<int> minutes('m', {}, "minutes", "Minutes from 0 to 59.", 0, 59);
+    cli::RuntimeArgumentParser<1> parser("set", "Set current time.");
+    CHECK(parser.addArgument(seconds));
+    CHECK_FALSE(parser.addArgument(minutes));
+}
+
+TEST_CASE("Test console doesn't allocate memory") {
+    Console console;
+    const size_t allocationsBefore = allocations;
+
+    // typing, editing and history
+    console.type("stat\t\t"sv);
+    console.type("us\r"sv);
+    console.type("statistics\x1b[D\x1b[D\b\x1b[3~\r"sv);
+    console.type("\x1b[A\x1b[A\x1b[B\r"sv);
+    console.type("\x12sta\x12\x07"sv);
+    console.type("xyz\r"sv);
+    // navigation and completion
+    console.type("cl\t\r"sv);
+    console.type("\t\ta\t\r"sv);
+    console.type("..\r"sv);
+    console.type("exit\r"sv);
+    // argument parsing, with help and errors
+    console.type("clock set -s 5 --minutes 3\r"sv);
+    console.type("/clock/set -s 7\r"sv);
+    console.type("clock set -h\r"sv);
+    console.type("clock set -x 1\r"sv);
+    console.type("clock set -s 99\r"sv);
+
+    CHECK(allocations == allocationsBefore);
+    CHECK(console.set.lastSeconds == 7);
+}
@@ -0,0 +1,79 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include "CLI.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<>;
+
+struct Console : TestConsole {
+    Console()
+        : level3(longName, on),
+          level2("level2", level3),
+          level1("level1", level2),
+          alarm("alarm", on),
+          clock("clock", alarm),
+          root(device, clock, level1),
+          cli(device, root) {
+        attach(cli);
+    }
+
+    static constexpr auto longName = "a_very_long_sub_menu_name_that_does_not_fit_into_prompt_buffer"sv;
+
+    Item on{"on"};
+    SubMenu<1> level3, level2, level1, alarm, clock;
+    MainMenu<2> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test prompt follows active menu") {
+    Console console;
+    CHECK(console.type("clock\r"sv) == "clock\n\r\n\r> clock > "sv);
+    CHECK(console.type("\r"sv) == "\n\r> clock > "sv);
+    CHECK(console.type("alarm\r"sv) == "alarm\n\r\n\r> clock > alarm > "sv);
+    CHECK(console.type("on\r"sv) == "on\n\r\n\r> clock > alarm > "sv);
+    CHECK(console.type("..\r"sv) == "..\n\r> clock > "sv);
+    CHECK(console.type("exit\r"sv) == "exit\n\r> "sv);
+    CHECK(console.type("/clock/alarm\r"sv) == "/clock/alarm\n\r\n\r> clock > alarm > "sv);
+    // command given by path doesn't change prompt
+    CHECK(console.type("/clock/alarm/on\r"sv) == "/clock/alarm/on\n\r\n\r> clock > alarm > "sv);
+}
+
+TEST_CASE("Test prompt longer than its buffer") {
+    Console console;
+    console.type("level1 level2\r"sv);
+    CHECK(console.type(Console::longName) == Console::longName);
+    CHECK(console.type("\r"sv) == "\n\r\n\r> level1 > level2 > a_very_long_sub_menu_name_that_does_not_fit_into_prompt_buffer > "sv);
+    CHECK(console.type("..\r"sv) == "..\n\r> level1 > level2 > "sv);
+}
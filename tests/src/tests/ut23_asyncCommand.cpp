@@ -0,0 +1,202 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "scriptRunner.h"
+#include "testConsole.h"
+#include "testItem.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Item = TestItem<ItemOutput::Name>;
+
+/**
+ * Reports whether it was cancelled.
+ */
+class Erase : public AsyncMenuItem {
+ public:
+    Erase() : AsyncMenuItem("erase") {}
+    int execute(std::string_view parameters, IODevice &port, const CancellationToken &token) final {
+        port.write(token.requested() ? "erase cancelled"sv : "erase done"sv);
+        port.write(parameters);
+        return token.requested();
+    }
+};
+
+/**
+ * Keeps started jobs, test runs them when it wants.
+ */
+class ManualExecutor : public CommandExecutor {
+ public:
+    bool start(CommandJob &job) noexcept final {
+        if (!accept) return false;
+        pending = &job;
+        return true;
+    }
+    void runPending() {
+        REQUIRE(pending != nullptr);
+        std::exchange(pending, nullptr)->run();
+    }
+
+    bool accept = true;
+    CommandJob *pending = nullptr;
+};
+
+struct Console : TestConsole {
+    Console() : root(device, status, erase), cli(device, root) {
+        attach(cli);
+        root.setExecutor(&executor);
+    }
+
+    Item status{"status"};
+    Erase erase;
+    ManualExecutor executor;
+    MainMenu<2> root;
+    CLI<> cli;
+};
+}  // namespace
+
+TEST_CASE("Test async command runs in executor and console keeps reading input") {
+    Console console;
+    CHECK(console.type("erase\r"sv) == "erase\n\r"sv);
+    REQUIRE(console.executor.pending != nullptr);
+    // typed ahead chars are neither echoed nor processed
+    CHECK(console.type("status\rsta"sv).empty());
+    CHECK(console.type(""sv).empty());
+
+    console.device.reset();
+    console.executor.runPending();
+    CHECK(console.device.text() == "erase done"sv);
+    CHECK(console.type(""sv) == "\n\r> status\n\rstatus\n\r> sta"sv);
+}
+
+TEST_CASE("Test ctrl-c cancels async command") {
+    Console console;
+    console.type("erase\r"sv);
+    CHECK(console.type("\x03"sv).empty());
+    console.device.reset();
+    console.executor.runPending();
+    CHECK(console.device.text() == "erase cancelled"sv);
+    CHECK(console.type(""sv) == "^C\n\r> "sv);
+
+    // next command isn't cancelled
+    console.type("erase 2\r"sv);
+    console.executor.runPending();
+    CHECK(console.type(""sv) == "\n\r> "sv);
+}
+
+TEST_CASE("Test typed ahead command that starts another async command") {
+    Console console;
+    console.type("erase 1\r"sv);
+    console.type("erase 2\rstatus\rst"sv);
+    console.executor.runPending();
+    CHECK(console.type(""sv) == "\n\r> erase 2\n\r"sv);
+    console.device.reset();
+    console.executor.runPending();
+    CHECK(console.device.text() == "erase done2"sv);
+    CHECK(console.type(""sv) == "\n\r> status\n\rstatus\n\r> st"sv);
+}
+
+TEST_CASE("Test async command runs synchronously when executor can't start it") {
+    Console console;
+    console.executor.accept = false;
+    CHECK(console.type("erase\rstatus\r"sv) == "erase\n\rerase done\n\r> status\n\rstatus\n\r> "sv);
+}
+
+TEST_CASE("Test async command runs synchronously in batch mode") {
+    CountingIODevice device;
+    Erase erase;
+    ManualExecutor executor;
+    MainMenu<1> root(device, erase);
+    root.setExecutor(&executor);
+    ScriptRunner runner(root);
+
+    const auto summary = runner.run("erase 1\nerase 2"sv);
+    CHECK(summary.executed == 2);
+    CHECK(device.text() == "erase done1erase done2"sv);
+    CHECK(executor.pending == nullptr);
+}
+
+TEST_CASE("Test async command in worker thread") {
+    /**
+     * Runs until it is cancelled.
+     */
+    class SelfTest : public AsyncMenuItem {
+     public:
+        SelfTest() : AsyncMenuItem("selftest") {}
+        int execute([[maybe_unused]] std::string_view parameters, IODevice &port, const CancellationToken &token) final {
+            running = true;
+            while (!token.requested())
+                std::this_thread::sleep_for(1ms);
+            port.write("stopped"sv);
+            return 1;
+        }
+        std::atomic<bool> running = false;
+    };
+
+    class ThreadExecutor : public CommandExecutor {
+     public:
+        ~ThreadExecutor() { join(); }
+        bool start(CommandJob &job) noexcept final {
+            join();
+            worker = std::thread([&job] { job.run(); });
+            return true;
+        }
+        void join() {
+            if (worker.joinable()) worker.join();
+        }
+
+     private:
+        std::thread worker;
+    };
+
+    CountingIODevice device;
+    SelfTest selfTest;
+    ThreadExecutor executor;
+    MainMenu<1> root(device, selfTest);
+    root.setExecutor(&executor);
+    CLI cli(device, root);
+
+    device.feed("selftest\r"sv);
+    cli.readInput();
+    while (!selfTest.running)
+        std::this_thread::sleep_for(1ms);
+    device.reset();
+    device.feed("ls\r\x03"sv);
+    cli.readInput();
+    executor.join();
+    cli.readInput();
+    CHECK(device.text() == "stopped^C\n\r> ls\n\r\tselftest\n\r> "sv);
+}
@@ -0,0 +1,211 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include "CLI.h"
+#include "countingIODevice.h"
+#include "scriptRunner.h"
+#include "testConsole.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+constexpr size_t lineLength = 50;
+
+/**
+ * Writes given count of lines, waiting for space in output before every line.
+ */
+class Dump : public CoroutineMenuItem {
+ public:
+    Dump() : CoroutineMenuItem("dump") {}
+    CommandTask execute(std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) final {
+        const int lines = parameters.empty() ? 20 : 1000;
+        for (int i = 0; i < lines; i++) {
+            if (!co_await writable(lineLength)) co_return 1;
+            std::string line = "line " + std::to_string(i);
+            line.resize(lineLength - 2, '.');
+            line += "\n\r";
+            port.write(line);
+        }
+        co_return 0;
+    }
+};
+
+class Wait : public CoroutineMenuItem {
+ public:
+    Wait() : CoroutineMenuItem("wait") {}
+    CommandTask execute([[maybe_unused]] std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) final {
+        const bool notCancelled = co_await sleep(20ms);
+        port.write(notCancelled ? "woke"sv : "interrupted"sv);
+        co_return 0;
+    }
+};
+
+class Tick : public CoroutineMenuItem {
+ public:
+    Tick() : CoroutineMenuItem("tick") {}
+    CommandTask execute([[maybe_unused]] std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) final {
+        for (int i = 0; i < 3; i++) {
+            port.write("tick"sv);
+            co_await yield();
+        }
+        co_return 0;
+    }
+};
+
+/**
+ * Sleeps with period shorter than its own run, so wake up time has always passed when it sleeps again.
+ */
+class Pulse : public CoroutineMenuItem {
+ public:
+    Pulse() : CoroutineMenuItem("pulse") {}
+    CommandTask execute([[maybe_unused]] std::string_view parameters, IODevice &port, [[maybe_unused]] const CancellationToken &token) final {
+        for (int i = 0; i < 3; i++) {
+            port.write("pulse"sv);
+            co_await sleep(0ms);
+        }
+        co_return 0;
+    }
+};
+
+struct Console : TestConsole {
+    Console() : root(device, dump, wait, tick, pulse), cli(device, root) { attach(cli); }
+
+    Dump dump;
+    Wait wait;
+    Tick tick;
+    Pulse pulse;
+    MainMenu<4> root;
+    CLI<> cli;
+};
+
+std::string expectedDump(int lines) {
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        std::string line = "line " + std::to_string(i);
+        line.resize(lineLength - 2, '.');
+        text += line + "\n\r";
+    }
+    return text;
+}
+}  // namespace
+
+TEST_CASE("Test coroutine command output is streamed between input polls") {
+    Console console;
+    console.type("dump\r"sv);
+    CHECK(console.cli.commandRunning());
+    std::string output(console.device.text());
+    CHECK(output.size() <= 2 * OUTPUTBUFFERLENGTH);
+
+    // typed ahead chars wait for command end
+    std::string_view chunk = console.type("st"sv);
+    CHECK(chunk.size() <= 2 * OUTPUTBUFFERLENGTH);
+    output += chunk;
+    while (console.cli.commandRunning()) {
+        chunk = console.type(""sv);
+        CHECK(chunk.size() <= 2 * OUTPUTBUFFERLENGTH);
+        output += chunk;
+    }
+    CHECK(output == "dump\n\r" + expectedDump(20) + "\n\r> st");
+}
+
+TEST_CASE("Test ctrl-c cancels coroutine command") {
+    Console console;
+    console.type("dump all\r"sv);
+    CHECK(console.cli.commandRunning());
+    const auto text = console.type("\x03"sv);
+    CHECK(text.ends_with("^C\n\r> "sv));
+    CHECK_FALSE(console.cli.commandRunning());
+}
+
+TEST_CASE("Test coroutine command sleeps without blocking console") {
+    Console console;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(console.type("wait\r"sv) == "wait\n\r"sv);
+    std::string_view text;
+    while ((text = console.type(""sv)).empty()) {
+        CHECK(console.cli.commandRunning());
+        std::this_thread::sleep_for(1ms);
+    }
+    CHECK(text == "woke\n\r> "sv);
+    CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+
+    console.type("wait\r"sv);
+    CHECK(console.type("\x03"sv) == "interrupted^C\n\r> "sv);
+}
+
+TEST_CASE("Test coroutine command yields to input poll") {
+    Console console;
+    CHECK(console.type("tick\r"sv) == "tick\n\rtick"sv);
+    CHECK(console.type(""sv) == "tick"sv);
+    CHECK(console.type(""sv) == "tick"sv);
+    CHECK(console.type(""sv) == "\n\r> "sv);
+}
+
+TEST_CASE("Test coroutine command sleeping again gives control back") {
+    Console console;
+    CHECK(console.type("pulse\r"sv) == "pulse\n\rpulse"sv);
+    CHECK(console.type(""sv) == "pulse"sv);
+    CHECK(console.type(""sv) == "pulse"sv);
+    CHECK(console.type(""sv) == "\n\r> "sv);
+}
+
+TEST_CASE("Test coroutine command runs to completion in script") {
+    CountingIODevice device;
+    Dump dump;
+    Wait wait;
+    MainMenu<2> root(device, dump, wait);
+    ScriptRunner runner(root);
+
+    const auto summary = runner.run("dump\nwait"sv);
+    CHECK(summary.executed == 2);
+    CHECK(summary.failed == 0);
+    CHECK(device.text() == expectedDump(20) + "woke");
+}
+
+TEST_CASE("Test coroutine frames come from fixed pool") {
+    CountingIODevice device;
+    Tick tick;
+    const CancellationToken token;
+    std::array<CommandTask, COROUTINEFRAMES> tasks;
+    for (auto &task : tasks) {
+        task = tick.start({}, device, token);
+        CHECK(static_cast<bool>(task));
+    }
+    CHECK_FALSE(tick.start({}, device, token));
+
+    MainMenu<1> root(device, tick);
+    CHECK(root.processCommand("tick"sv, MainMenuBase::Mode::Batch).failed());
+
+    // released frame is reused
+    tasks[0] = {};
+    CHECK(root.processCommand("tick"sv, MainMenuBase::Mode::Batch).value == 0);
+}
@@ -0,0 +1,154 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "CLI.h"
+#include "testConsole.h"
+#include "watch.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+/**
+ * Prints given lines, every call increments uptime.
+ */
+class Status : public MenuItem {
+ public:
+    Status() : MenuItem("status") {}
+    int execute([[maybe_unused]] std::string_view parameters, IODevice &port) final {
+        port.write("uptime "sv);
+        port.write(std::to_string(uptime));
+        port.write("\n\r"sv);
+        for (const auto &line : lines) {
+            port.write(line);
+            port.write("\n\r"sv);
+        }
+        uptime += step;
+        return 0;
+    }
+
+    int uptime = 0;
+    int step = 1;
+    std::vector<std::string> lines{"state ok", "voltage 3.3"};
+};
+
+struct Console : TestConsole {
+    Console() : clock("clock", status), root(device, clock), cli(device, root) {
+        attach(cli);
+        root.setWatch(&watch);
+    }
+
+    /**
+     * Polls console two hours after now, so one hour watch interval has always passed, while type() never reaches it.
+     */
+    std::string_view poll() {
+        device.reset();
+        cli.readInput(CommandTask::Clock::now() + 2h);
+        terminal.process(device.text());
+        return device.text();
+    }
+
+    Status status;
+    SubMenu<1> clock;
+    MainMenu<1> root;
+    CLI<> cli;
+    Watch<> watch;
+};
+}  // namespace
+
+TEST_CASE("Test watch sends only changed lines") {
+    Console console;
+    CHECK(console.type("watch 3600s clock status\r"sv) == "watch 3600s clock status\n\ruptime 0\n\rstate ok\n\rvoltage 3.3\n\r"sv);
+    CHECK(console.cli.commandRunning());
+
+    CHECK(console.poll() == "\x1b[3A\ruptime 1\x1b[K\x1b[3B\r"sv);
+    CHECK(console.terminal.rowText(2) == "uptime 1"sv);
+    CHECK(console.terminal.rowText(3) == "state ok"sv);
+
+    // unchanged output costs nothing
+    console.status.step = 0;
+    console.poll();
+    CHECK(console.poll().empty());
+
+    console.status.lines[1] = "voltage 3.0";
+    CHECK(console.poll() == "\x1b[1A\rvoltage 3.0\x1b[K\x1b[1B\r"sv);
+    CHECK(console.terminal.rowText(4) == "voltage 3.0"sv);
+
+    // longer output is appended, shorter one erases the rest
+    console.status.lines.push_back("current 10mA");
+    CHECK(console.poll() == "current 10mA\n\r"sv);
+    CHECK(console.terminal.rowText(5) == "current 10mA"sv);
+    console.status.lines.resize(1);
+    CHECK(console.poll() == "\x1b[2A\x1b[J"sv);
+    CHECK(console.terminal.rowText(4).empty());
+    CHECK(console.terminal.rowText(5).empty());
+    CHECK(console.terminal.rowText(3) == "state ok"sv);
+
+    // any key stops watch and isn't processed as input
+    CHECK(console.type("q"sv) == "\n\r> "sv);
+    CHECK_FALSE(console.cli.commandRunning());
+    CHECK(console.type("\r"sv) == "\n\r> "sv);
+}
+
+TEST_CASE("Test watch sends less than repeated command") {
+    Console console;
+    console.status.lines = {"state ok", "voltage 3.3", "temperature 25C", "humidity 40%"};
+    std::string_view full = console.type("watch 3600s clock status\r"sv);
+    full.remove_prefix("watch 3600s clock status\n\r"sv.size());
+    const size_t runBytes = full.size();
+
+    size_t sent = 0;
+    for (int i = 0; i < 10; i++) {
+        sent += console.poll().size();
+    }
+    CHECK(sent < 10 * runBytes / 2);
+    console.type("q"sv);
+}
+
+TEST_CASE("Test watch reports wrong use") {
+    Console console;
+    CHECK(console.type("watch clock status\r"sv) == "watch clock status\n\r\tusage: watch <interval>[ms|s] <command>\n\r> "sv);
+    CHECK(console.type("watch 1s\r"sv) == "watch 1s\n\r\tusage: watch <interval>[ms|s] <command>\n\r> "sv);
+    CHECK(console.type("watch 1s nothing\r"sv) == "watch 1s nothing\n\r\tno such command...\n\r> "sv);
+    // watched sub menu doesn't change prompt
+    CHECK(console.type("watch 1s clock\r"sv) == "watch 1s clock\n\r\tnot a command...\n\r> "sv);
+
+    CHECK(console.root.processCommand("watch 1s clock status"sv, MainMenuBase::Mode::Batch).failed());
+    CHECK(console.status.uptime == 0);
+}
+
+TEST_CASE("Test watch is available only when given to menu") {
+    Console console;
+    console.root.setWatch(nullptr);
+    CHECK(console.type("watch 3600s clock status\r"sv) == "watch 3600s clock status\n\r\tno such command...\n\r> "sv);
+    CHECK_FALSE(console.cli.commandRunning());
+    CHECK(console.status.uptime == 0);
+}
@@ -0,0 +1,189 @@
+/**
+ * @license    BSD 3-Clause
+ * @copyright  Pawel Okas
+ * @version    $Id$
+ * @brief
+ *
+ * @authors    Pawel Okas
+ *
+ * @copyright Copyright (c) 2021, Pawel Okas
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the
+ *        documentation and/or other materials provided with the distribution.
+ *     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this
+ *        software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+#include "countingIODevice.h"
+#include "mainMenu.h"
+#include "scheduler.h"
+
+using namespace microhal;
+using namespace std::literals;
+
+namespace {
+using Clock = SchedulerBase::Clock;
+
+/**
+ * Remembers time of every run.
+ */
+class Probe : public MenuItem {
+ public:
+    Probe(std::string_view name, const Clock::duration &now) : MenuItem(name), now(now) {}
+    int execute(std::string_view parameters, [[maybe_unused]] IODevice &port) final {
+        runs.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+        lastParameters = parameters;
+        return 0;
+    }
+
+    const Clock::duration &now;
+    std::vector<long> runs;
+    std::string lastParameters;
+};
+
+/**
+ * Cancels entry given as parameter.
+ */
+class Stop : public MenuItem {
+ public:
+    Stop(SchedulerBase &scheduler) : MenuItem("stop"), scheduler(scheduler) {}
+    int execute(std::string_view parameters, [[maybe_unused]] IODevice &port) final {
+        scheduler.cancel(std::stoul(std::string(parameters)));
+        return 0;
+    }
+
+    SchedulerBase &scheduler;
+};
+
+struct Fixture {
+    Fixture()
+        : read("read", now),
+          reboot("reboot", now),
+          sensor("sensor", read),
+          scheduler(root, device),
+          stop(scheduler),
+          schedule("schedule", scheduler.everyCommand, scheduler.atCommand, scheduler.listCommand, scheduler.cancelCommand),
+          root(device, sensor, reboot, stop, schedule) {
+        scheduler.poll(Clock::time_point{});
+    }
+
+    /**
+     * Moves mock clock forward, scheduler is polled every step.
+     */
+    void advance(Clock::duration time, Clock::duration step = 1ms) {
+        for (const auto end = now + time; now < end;) {
+            now = std::min(now + step, end);
+            scheduler.poll(Clock::time_point{now});
+        }
+    }
+
+    std::string_view run(std::string_view commandLine) {
+        device.reset();
+        root.processCommand(commandLine, MainMenuBase::Mode::Batch);
+        return device.text();
+    }
+
+    Clock::duration now{};
+    CountingIODevice device;
+    Probe read, reboot;
+    SubMenu<1> sensor;
+    // only reference to the menu is kept, so scheduler may be constructed before the menu with its commands
+    Scheduler<48> scheduler;
+    Stop stop;
+    SubMenu<4> schedule;
+    MainMenu<4> root;
+};
+}  // namespace
+
+TEST_CASE("Test scheduler runs periodic and delayed commands on time") {
+    Fixture fixture;
+    CHECK(fixture.run("schedule every 500ms sensor read -v"sv) == "\tid 1"sv);
+    CHECK(fixture.run("schedule at +2s reboot"sv) == "\tid 2"sv);
+    CHECK(fixture.scheduler.size() == 2);
+
+    fixture.advance(2100ms);
+    CHECK(fixture.read.runs == std::vector<long>{500, 1000, 1500, 2000});
+    CHECK(fixture.read.lastParameters == "-v");
+    CHECK(fixture.reboot.runs == std::vector<long>{2000});
+    CHECK(fixture.scheduler.size() == 1);
+
+    // coarse polling runs every missed tick
+    fixture.advance(1s, 300ms);
+    CHECK(fixture.read.runs.size() == 6);
+    CHECK(fixture.read.runs.back() == 3000);
+}
+
+TEST_CASE("Test scheduler handles dozens of entries") {
+    Fixture fixture;
+    for (int period = 1; period <= 48; period++) {
+        CHECK(fixture.scheduler.schedule("sensor read"sv, std::chrono::milliseconds(period * 7), std::chrono::milliseconds(period * 7)));
+    }
+    CHECK_FALSE(fixture.scheduler.schedule("sensor read"sv, 1ms));
+
+    constexpr int duration = 10'000;
+    fixture.advance(std::chrono::milliseconds(duration));
+    size_t expected = 0;
+    for (int period = 1; period <= 48; period++)
+        expected += duration / (period * 7);
+    CHECK(fixture.read.runs.size() == expected);
+    CHECK(std::is_sorted(fixture.read.runs.begin(), fixture.read.runs.end()));
+}
+
+TEST_CASE("Test scheduler delays beyond wheel range") {
+    Fixture fixture;
+    // 2^24 ticks is the range of four levels
+    CHECK(fixture.scheduler.schedule("reboot"sv, 5h));
+    CHECK(fixture.scheduler.schedule("sensor read"sv, 70s));
+    fixture.advance(6h, 1s);
+    CHECK(fixture.read.runs == std::vector<long>{70'000});
+    CHECK(fixture.reboot.runs == std::vector<long>{5 * 3600 * 1000});
+}
+
+TEST_CASE("Test scheduler cancel") {
+    Fixture fixture;
+    const auto every = fixture.scheduler.schedule("sensor read"sv, 10ms, 10ms);
+    fixture.advance(35ms);
+    CHECK(fixture.run("schedule cancel "s + std::to_string(every)).empty());
+    fixture.advance(35ms);
+    CHECK(fixture.read.runs.size() == 3);
+    CHECK(fixture.run("schedule cancel "s + std::to_string(every)) == "\tno such entry..."sv);
+
+    // reused entry gets new id
+    const auto reused = fixture.scheduler.schedule("reboot"sv, 10ms);
+    CHECK(reused != every);
+    CHECK_FALSE(fixture.scheduler.cancel(every));
+
+    // command may cancel its own entry, released entry is reused with next generation id
+    CHECK(fixture.scheduler.cancel(reused));
+    const auto self = reused + 48;
+    CHECK(fixture.scheduler.schedule("stop "s + std::to_string(self), 5ms, 5ms) == self);
+    fixture.advance(20ms);
+    CHECK(fixture.scheduler.size() == 0);
+}
+
+TEST_CASE("Test scheduler management commands report errors and list entries") {
+    Fixture fixture;
+    CHECK(fixture.run("schedule every 500 sensor"sv) == "\tno such command..."sv);
+    CHECK(fixture.run("schedule every sensor read"sv) == "\tusage: every <interval> <command>"sv);
+    CHECK(fixture.run("schedule at 10s reboot"sv) == "\tusage: at +<delay> <command>"sv);
+    CHECK(fixture.run("schedule at +10s reboot with a very long parameters list"sv) == "\tcommand line too long..."sv);
+
+    fixture.run("schedule every 500ms sensor read"sv);
+    fixture.run("schedule at +1min reboot"sv);
+    fixture.advance(200ms);
+    CHECK(fixture.run("schedule list"sv) == "\n\r\t1\tevery 500ms\tnext in 300ms\tsensor read\n\r\t2\tonce\tnext in 59800ms\treboot"sv);
+}